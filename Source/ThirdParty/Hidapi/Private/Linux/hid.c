@@ -35,6 +35,7 @@
 #include <sys/utsname.h>
 #include <fcntl.h>
 #include <poll.h>
+#include <sys/eventfd.h>
 
 /* Linux */
 #include <linux/hidraw.h>
@@ -43,6 +44,7 @@
 #include <libudev.h>
 
 #include "hidapi.h"
+#include "hidapi_hidraw.h"
 
 #ifdef HIDAPI_ALLOW_BUILD_WORKAROUND_KERNEL_2_6_39
 /* This definitions first appeared in Linux Kernel 2.6.39 in linux/hidraw.h.
@@ -73,6 +75,7 @@
 
 struct hid_device_ {
 	int device_handle;
+	int interrupt_fd;
 	int blocking;
 	wchar_t *last_error_str;
 	wchar_t *last_read_error_str;
@@ -96,6 +99,7 @@ static hid_device *new_hid_device(void)
 	}
 
 	dev->device_handle = -1;
+	dev->interrupt_fd = -1;
 	dev->blocking = 1;
 	dev->last_error_str = NULL;
 	dev->last_read_error_str = NULL;
@@ -1099,6 +1103,9 @@ hid_device * HID_API_EXPORT hid_open_path(const char *path)
 			return NULL;
 		}
 
+		/* Used by hid_hidraw_interrupt_read() to wake up blocked reads. */
+		dev->interrupt_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
 		return dev;
 	}
 	else {
@@ -1141,20 +1148,29 @@ int HID_API_EXPORT hid_read_timeout(hid_device *dev, unsigned char *data, size_t
 
 	int bytes_read;
 
-	if (milliseconds >= 0) {
+	if (milliseconds >= 0 || dev->interrupt_fd >= 0) {
 		/* Milliseconds is either 0 (non-blocking) or > 0 (contains
 		   a valid timeout). In both cases we want to call poll()
 		   and wait for data to arrive.  Don't rely on non-blocking
 		   operation (O_NONBLOCK) since some kernels don't seem to
 		   properly report device disconnection through read() when
-		   in non-blocking mode.  */
+		   in non-blocking mode.
+		   Blocking reads (-1) are done with poll() too, so that
+		   hid_hidraw_interrupt_read() can wake them up. */
 		int ret;
-		struct pollfd fds;
-
-		fds.fd = dev->device_handle;
-		fds.events = POLLIN;
-		fds.revents = 0;
-		ret = poll(&fds, 1, milliseconds);
+		nfds_t nfds = 1;
+		struct pollfd fds[2];
+
+		fds[0].fd = dev->device_handle;
+		fds[0].events = POLLIN;
+		fds[0].revents = 0;
+		if (dev->interrupt_fd >= 0) {
+			fds[1].fd = dev->interrupt_fd;
+			fds[1].events = POLLIN;
+			fds[1].revents = 0;
+			nfds = 2;
+		}
+		ret = poll(fds, nfds, milliseconds);
 		if (ret == 0) {
 			/* Timeout */
 			return ret;
@@ -1165,9 +1181,16 @@ int HID_API_EXPORT hid_read_timeout(hid_device *dev, unsigned char *data, size_t
 			return ret;
 		}
 		else {
+			/* The eventfd is never consumed, every following read is interrupted too. */
+			if (nfds > 1 && (fds[1].revents & POLLIN)) {
+				errno = EINTR;
+				register_error_str(&dev->last_read_error_str, "hid_read_timeout: interrupted");
+				return -1;
+			}
+
 			/* Check for errors on the file descriptor. This will
 			   indicate a device disconnection. */
-			if (fds.revents & (POLLERR | POLLHUP | POLLNVAL)) {
+			if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
 				// We cannot use strerror() here as no -1 was returned from poll().
 				errno = EIO;
 				register_error_str(&dev->last_read_error_str, "hid_read_timeout: unexpected poll error (device disconnected)");
@@ -1293,6 +1316,9 @@ void HID_API_EXPORT hid_close(hid_device *dev)
 
 	close(dev->device_handle);
 
+	if (dev->interrupt_fd >= 0)
+		close(dev->interrupt_fd);
+
 	free(dev->last_error_str);
 	free(dev->last_read_error_str);
 
@@ -1404,6 +1430,33 @@ int HID_API_EXPORT_CALL hid_get_indexed_string(hid_device *dev, int string_index
 }
 
 
+int HID_API_EXPORT_CALL hid_hidraw_get_fd(hid_device *dev)
+{
+	if (!dev) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return dev->device_handle;
+}
+
+
+int HID_API_EXPORT_CALL hid_hidraw_interrupt_read(hid_device *dev)
+{
+	const uint64_t value = 1;
+
+	if (!dev || dev->interrupt_fd < 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (write(dev->interrupt_fd, &value, sizeof(value)) != sizeof(value))
+		return -1;
+
+	return 0;
+}
+
+
 int HID_API_EXPORT_CALL hid_get_report_descriptor(hid_device *dev, unsigned char *buf, size_t buf_size)
 {
 	struct hidraw_report_descriptor rpt_desc;
@@ -0,0 +1,66 @@
+/*******************************************************
+ HIDAPI - Multi-Platform library for
+ communication with HID devices.
+
+ libusb/hidapi Team
+
+ Copyright 2022, All Rights Reserved.
+
+ At the discretion of the user of this library,
+ this software may be licensed under the terms of the
+ GNU General Public License v3, a BSD-Style license, or the
+ original HIDAPI license as outlined in the LICENSE.txt,
+ LICENSE-gpl3.txt, LICENSE-bsd.txt, and LICENSE-orig.txt
+ files located at the root of the source distribution.
+ These files may also be found in the public source
+ code repository located at:
+        https://github.com/libusb/hidapi .
+********************************************************/
+
+/** @file
+ * @defgroup API hidapi API
+ */
+
+#ifndef HIDAPI_HIDRAW_H__
+#define HIDAPI_HIDRAW_H__
+
+#include "hidapi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+		/** @brief Get the hidraw file descriptor of a HID device.
+
+			The descriptor can be added to a poll()/epoll() set to wait
+			for input reports of multiple devices from a single thread.
+			It is owned by the device: do not read from it or close it,
+			use @ref hid_read_timeout and @ref hid_close.
+
+			@ingroup API
+			@param dev A device handle returned from hid_open().
+
+			@returns
+				This function returns the file descriptor on success and -1 on error.
+		*/
+		int HID_API_EXPORT_CALL hid_hidraw_get_fd(hid_device *dev);
+
+		/** @brief Wakes up a blocked hid_read/hid_read_timeout call.
+
+			The interrupted call (and every following one) returns -1,
+			so a reader thread can wait with an infinite timeout and still be stopped.
+			Can be called from any thread.
+
+			@ingroup API
+			@param dev A device handle returned from hid_open().
+
+			@returns
+				This function returns 0 on success and -1 on error.
+		*/
+		int HID_API_EXPORT_CALL hid_hidraw_interrupt_read(hid_device *dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -141,6 +141,7 @@ struct hid_device_ {
 	pthread_barrier_t barrier; /* Ensures correct startup sequence */
 	pthread_barrier_t shutdown_barrier; /* Ensures correct shutdown sequence */
 	int shutdown_thread;
+	int read_interrupted;
 	wchar_t *last_error_str;
 	wchar_t *last_read_error_str;
 };
@@ -163,6 +164,7 @@ static hid_device *new_hid_device(void)
 	dev->input_reports = NULL;
 	dev->device_info = NULL;
 	dev->shutdown_thread = 0;
+	dev->read_interrupted = 0;
 	dev->last_error_str = NULL;
 	dev->last_read_error_str = NULL;
 
@@ -1220,7 +1222,7 @@ static int cond_wait(hid_device *dev, pthread_cond_t *cond, pthread_mutex_t *mut
 		   to sleep. See the pthread_cond_timedwait() man page for
 		   details. */
 
-		if (dev->shutdown_thread || dev->disconnected) {
+		if (dev->shutdown_thread || dev->disconnected || dev->read_interrupted) {
 			return -1;
 		}
 	}
@@ -1241,7 +1243,7 @@ static int cond_timedwait(hid_device *dev, pthread_cond_t *cond, pthread_mutex_t
 		   to sleep. See the pthread_cond_timedwait() man page for
 		   details. */
 
-		if (dev->shutdown_thread || dev->disconnected) {
+		if (dev->shutdown_thread || dev->disconnected || dev->read_interrupted) {
 			return -1;
 		}
 	}
@@ -1286,6 +1288,13 @@ int HID_API_EXPORT hid_read_timeout(hid_device *dev, unsigned char *data, size_t
 		goto ret;
 	}
 
+	if (dev->read_interrupted) {
+		/* hid_darwin_interrupt_read() has been called. */
+		bytes_read = -1;
+		register_error_str(&dev->last_read_error_str, "hid_read_timeout: interrupted");
+		goto ret;
+	}
+
 	/* There is no data. Go to sleep and wait for data. */
 
 	if (milliseconds == -1) {
@@ -1532,6 +1541,20 @@ int HID_API_EXPORT_CALL hid_darwin_get_location_id(hid_device *dev, uint32_t *lo
 	}
 }
 
+int HID_API_EXPORT_CALL hid_darwin_interrupt_read(hid_device *dev)
+{
+	if (!dev) {
+		return -1;
+	}
+
+	pthread_mutex_lock(&dev->mutex);
+	dev->read_interrupted = 1;
+	pthread_cond_broadcast(&dev->condition);
+	pthread_mutex_unlock(&dev->mutex);
+
+	return 0;
+}
+
 void HID_API_EXPORT_CALL hid_darwin_set_open_exclusive(int open_exclusive)
 {
 	device_open_options = (open_exclusive == 0) ? kIOHIDOptionsTypeNone : kIOHIDOptionsTypeSeizeDevice;
@@ -91,6 +91,20 @@ extern "C" {
 		*/
 		int HID_API_EXPORT_CALL hid_darwin_is_device_open_exclusive(hid_device *dev);
 
+		/** @brief Wakes up a blocked hid_read/hid_read_timeout call.
+
+			The interrupted call (and every following one) returns -1,
+			so a reader thread can wait with an infinite timeout and still be stopped.
+			Can be called from any thread.
+
+			@ingroup API
+			@param dev A device handle returned from hid_open().
+
+			@returns
+				This function returns 0 on success and -1 on error.
+		*/
+		int HID_API_EXPORT_CALL hid_darwin_interrupt_read(hid_device *dev);
+
 #ifdef __cplusplus
 }
 #endif
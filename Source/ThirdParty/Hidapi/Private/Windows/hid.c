@@ -194,6 +194,7 @@ struct hid_device_ {
 		char *read_buf;
 		OVERLAPPED ol;
 		OVERLAPPED write_ol;
+		HANDLE read_interrupt_event;
 		struct hid_device_info* device_info;
 		DWORD write_timeout_ms;
 };
@@ -221,6 +222,7 @@ static hid_device *new_hid_device()
 	dev->ol.hEvent = CreateEvent(NULL, FALSE, FALSE /*initial state f=nonsignaled*/, NULL);
 	memset(&dev->write_ol, 0, sizeof(dev->write_ol));
 	dev->write_ol.hEvent = CreateEvent(NULL, FALSE, FALSE /*initial state f=nonsignaled*/, NULL);
+	dev->read_interrupt_event = CreateEvent(NULL, TRUE /*manual reset*/, FALSE /*initial state f=nonsignaled*/, NULL);
 	dev->device_info = NULL;
 	dev->write_timeout_ms = 1000;
 
@@ -231,6 +233,7 @@ static void free_hid_device(hid_device *dev)
 {
 	CloseHandle(dev->ol.hEvent);
 	CloseHandle(dev->write_ol.hEvent);
+	CloseHandle(dev->read_interrupt_event);
 	CloseHandle(dev->device_handle);
 	free(dev->last_error_str);
 	free(dev->last_read_error_str);
@@ -1190,8 +1193,14 @@ int HID_API_EXPORT HID_API_CALL hid_read_timeout(hid_device *dev, unsigned char
 	}
 
 	if (overlapped) {
-		/* See if there is any data yet. */
-		res = WaitForSingleObject(ev, milliseconds >= 0 ? (DWORD)milliseconds : INFINITE);
+		/* See if there is any data yet (or if hid_winapi_interrupt_read() has been called). */
+		HANDLE events[2] = { ev, dev->read_interrupt_event };
+		res = WaitForMultipleObjects(2, events, FALSE, milliseconds >= 0 ? (DWORD)milliseconds : INFINITE);
+		if (res == WAIT_OBJECT_0 + 1) {
+			/* Leave the Overlapped I/O running, it will be cancelled by hid_close(). */
+			register_string_error_to_buffer(&dev->last_read_error_str, L"hid_read_timeout: interrupted");
+			return -1;
+		}
 		if (res != WAIT_OBJECT_0) {
 			/* There was no data this time. Return zero bytes available,
 			   but leave the Overlapped I/O running. */
@@ -1508,6 +1517,15 @@ int HID_API_EXPORT_CALL HID_API_CALL hid_get_indexed_string(hid_device *dev, int
 	return 0;
 }
 
+int HID_API_EXPORT_CALL hid_winapi_interrupt_read(hid_device *dev)
+{
+	if (!dev || !dev->read_interrupt_event) {
+		return -1;
+	}
+
+	return SetEvent(dev->read_interrupt_event) ? 0 : -1;
+}
+
 int HID_API_EXPORT_CALL hid_winapi_get_container_id(hid_device *dev, GUID *container_id)
 {
 	wchar_t *interface_path = NULL, *device_id = NULL;
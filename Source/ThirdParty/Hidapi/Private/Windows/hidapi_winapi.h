@@ -87,6 +87,20 @@ extern "C" {
 		 */
 		void HID_API_EXPORT_CALL hid_winapi_set_write_timeout(hid_device *dev, unsigned long timeout);
 
+		/**
+		 * @brief Wakes up a blocked hid_read/hid_read_timeout call.
+		 *
+		 * The interrupted call (and every following one) returns -1,
+		 * so a reader thread can wait with an infinite timeout and still be stopped.
+		 * Can be called from any thread.
+		 *
+		 * @param dev A device handle returned from hid_open().
+		 *
+		 * @returns
+		 *   This function returns 0 on success and -1 on error.
+		 */
+		int HID_API_EXPORT_CALL hid_winapi_interrupt_read(hid_device *dev);
+
 #ifdef __cplusplus
 }
 #endif
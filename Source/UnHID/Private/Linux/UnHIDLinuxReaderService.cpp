@@ -0,0 +1,242 @@
+// Copyright 2026 - Roberto De Ioris
+
+#include "UnHIDLinuxReaderService.h"
+#include "UnHIDDeviceReader.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "hidapi_hidraw.h"
+THIRD_PARTY_INCLUDES_END
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+
+namespace UnHID
+{
+	// devices can be destroyed by the garbage collector outside of the game thread
+	static FCriticalSection LinuxReaderServiceLock;
+	static TUniquePtr<FUnHIDLinuxReaderService> LinuxReaderService;
+}
+
+FUnHIDLinuxReaderService& FUnHIDLinuxReaderService::Get()
+{
+	FScopeLock Lock(&UnHID::LinuxReaderServiceLock);
+
+	if (!UnHID::LinuxReaderService)
+	{
+		UnHID::LinuxReaderService = TUniquePtr<FUnHIDLinuxReaderService>(new FUnHIDLinuxReaderService());
+	}
+
+	return *UnHID::LinuxReaderService;
+}
+
+FUnHIDLinuxReaderService* FUnHIDLinuxReaderService::GetPtr()
+{
+	FScopeLock Lock(&UnHID::LinuxReaderServiceLock);
+
+	return UnHID::LinuxReaderService.Get();
+}
+
+void FUnHIDLinuxReaderService::Shutdown()
+{
+	FScopeLock Lock(&UnHID::LinuxReaderServiceLock);
+
+	UnHID::LinuxReaderService.Reset();
+}
+
+FUnHIDLinuxReaderService::FUnHIDLinuxReaderService() : bStopThread(false)
+{
+	EpollFd = epoll_create1(EPOLL_CLOEXEC);
+	WakeupFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (EpollFd >= 0 && WakeupFd >= 0)
+	{
+		// the wakeup event is the only one without a reader
+		struct epoll_event Event = {};
+		Event.events = EPOLLIN;
+		Event.data.ptr = nullptr;
+		if (epoll_ctl(EpollFd, EPOLL_CTL_ADD, WakeupFd, &Event) != 0)
+		{
+			return;
+		}
+
+		Thread = FRunnableThread::Create(this, TEXT("UnHIDLinuxReaderService"));
+	}
+}
+
+FUnHIDLinuxReaderService::~FUnHIDLinuxReaderService()
+{
+	Stop();
+	if (Thread)
+	{
+		Thread->WaitForCompletion();
+		delete Thread;
+	}
+
+	Thread = nullptr;
+
+	if (EpollFd >= 0)
+	{
+		close(EpollFd);
+	}
+
+	EpollFd = -1;
+
+	if (WakeupFd >= 0)
+	{
+		close(WakeupFd);
+	}
+
+	WakeupFd = -1;
+}
+
+bool FUnHIDLinuxReaderService::Register(FUnHIDDeviceReader* Reader)
+{
+	if (!Thread || !Reader)
+	{
+		return false;
+	}
+
+	const int32 Fd = hid_hidraw_get_fd(Reader->GetHidDevice());
+	if (Fd < 0)
+	{
+		return false;
+	}
+
+	FScopeLock Lock(&ReadersLock);
+
+	struct epoll_event Event = {};
+	Event.events = EPOLLIN;
+	Event.data.ptr = Reader;
+	if (epoll_ctl(EpollFd, EPOLL_CTL_ADD, Fd, &Event) != 0)
+	{
+		return false;
+	}
+
+	Readers.Add(Reader);
+
+	return true;
+}
+
+void FUnHIDLinuxReaderService::Unregister(FUnHIDDeviceReader* Reader)
+{
+	FEvent* UnpinnedEvent = nullptr;
+
+	{
+		FScopeLock Lock(&ReadersLock);
+
+		FUnHIDLinuxReaderEntry* Entry = Readers.Find(Reader);
+		if (!Entry)
+		{
+			return;
+		}
+
+		const int32 Fd = hid_hidraw_get_fd(Reader->GetHidDevice());
+		if (Fd >= 0)
+		{
+			epoll_ctl(EpollFd, EPOLL_CTL_DEL, Fd, nullptr);
+		}
+
+		if (Entry->NumPins == 0)
+		{
+			Readers.Remove(Reader);
+			return;
+		}
+
+		// the service thread is reading it, the entry is removed by the unpin
+		UnpinnedEvent = FPlatformProcess::GetSynchEventFromPool(true);
+		Entry->UnpinnedEvent = UnpinnedEvent;
+	}
+
+	UnpinnedEvent->Wait();
+	FPlatformProcess::ReturnSynchEventToPool(UnpinnedEvent);
+}
+
+uint32 FUnHIDLinuxReaderService::Run()
+{
+	struct epoll_event Events[64];
+
+	while (!bStopThread)
+	{
+		const int32 NumEvents = epoll_wait(EpollFd, Events, UE_ARRAY_COUNT(Events), -1);
+		if (NumEvents < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			break;
+		}
+
+		TArray<FUnHIDDeviceReader*, TInlineAllocator<UE_ARRAY_COUNT(Events)>> PinnedReaders;
+
+		{
+			FScopeLock Lock(&ReadersLock);
+
+			for (int32 EventIndex = 0; EventIndex < NumEvents; EventIndex++)
+			{
+				FUnHIDDeviceReader* Reader = reinterpret_cast<FUnHIDDeviceReader*>(Events[EventIndex].data.ptr);
+				// wakeup from Stop(), the loop condition will do the rest
+				if (!Reader)
+				{
+					continue;
+				}
+
+				// the device could have been unregistered after epoll_wait() returned
+				FUnHIDLinuxReaderEntry* Entry = Readers.Find(Reader);
+				if (!Entry || Entry->UnpinnedEvent)
+				{
+					continue;
+				}
+
+				Entry->NumPins++;
+				PinnedReaders.Add(Reader);
+			}
+		}
+
+		for (FUnHIDDeviceReader* Reader : PinnedReaders)
+		{
+			// EPOLLERR/EPOLLHUP are reported by the read itself
+			const bool bReadError = Reader->ReadReport(0) < 0;
+
+			FScopeLock Lock(&ReadersLock);
+
+			FUnHIDLinuxReaderEntry& Entry = Readers.FindChecked(Reader);
+			Entry.NumPins--;
+
+			if (Entry.UnpinnedEvent)
+			{
+				if (Entry.NumPins == 0)
+				{
+					FEvent* UnpinnedEvent = Entry.UnpinnedEvent;
+					Readers.Remove(Reader);
+					UnpinnedEvent->Trigger();
+				}
+			}
+			else if (bReadError)
+			{
+				const int32 Fd = hid_hidraw_get_fd(Reader->GetHidDevice());
+				epoll_ctl(EpollFd, EPOLL_CTL_DEL, Fd, nullptr);
+				Readers.Remove(Reader);
+			}
+		}
+	}
+
+	return 0;
+}
+
+void FUnHIDLinuxReaderService::Stop()
+{
+	bStopThread = true;
+
+	if (WakeupFd >= 0)
+	{
+		const uint64 Value = 1;
+		if (write(WakeupFd, &Value, sizeof(Value)) < 0)
+		{
+			// the counter is already signaled
+		}
+	}
+}
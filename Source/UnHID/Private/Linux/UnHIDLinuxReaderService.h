@@ -0,0 +1,56 @@
+// Copyright 2026 - Roberto De Ioris
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+
+class FUnHIDDeviceReader;
+
+/**
+ * Single reader thread for all of the opened hidraw devices.
+ * Every device file descriptor is multiplexed through one epoll set,
+ * so opening dozens of devices does not spawn dozens of threads.
+ * The thread sleeps in epoll_wait() until a device is readable or Stop() signals the wakeup eventfd.
+ * Ready readers are pinned and read without holding the lock, so registering (or unregistering) a device never waits
+ * for the reads of the other devices.
+ */
+class FUnHIDLinuxReaderService : public FRunnable
+{
+public:
+	static FUnHIDLinuxReaderService& Get();
+	// does not start the service
+	static FUnHIDLinuxReaderService* GetPtr();
+	static void Shutdown();
+
+	virtual ~FUnHIDLinuxReaderService();
+
+	bool Register(FUnHIDDeviceReader* Reader);
+
+	// when it returns the reader is no more accessed by the service thread (waits only if that reader is being read)
+	void Unregister(FUnHIDDeviceReader* Reader);
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	FUnHIDLinuxReaderService();
+
+	int32 EpollFd = -1;
+	int32 WakeupFd = -1;
+
+	FRunnableThread* Thread = nullptr;
+	TAtomic<bool> bStopThread;
+
+	struct FUnHIDLinuxReaderEntry
+	{
+		// the service thread is reading it
+		int32 NumPins = 0;
+		// set by Unregister while the reader is pinned, triggered by the last unpin
+		FEvent* UnpinnedEvent = nullptr;
+	};
+
+	FCriticalSection ReadersLock;
+	TMap<FUnHIDDeviceReader*, FUnHIDLinuxReaderEntry> Readers;
+};
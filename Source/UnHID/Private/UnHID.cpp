@@ -1,6 +1,11 @@
 // Copyright 2026 - Roberto De Ioris
 
 #include "UnHID.h"
+#include "UnHIDDescriptorCache.h"
+#include "UnHIDFeaturePollScheduler.h"
+#if PLATFORM_LINUX
+#include "Linux/UnHIDLinuxReaderService.h"
+#endif
 
 #define LOCTEXT_NAMESPACE "FUnHIDModule"
 
@@ -116,12 +121,20 @@ void FUnHIDModule::StartupModule()
 		EKeys::AddKey(FKeyDetails(ButtonName, FText::FromString(FString::Printf(TEXT("UnHID Button %u"), Index)), FKeyDetails::GamepadKey, NAME_UnHID));
 		ButtonCache.Add(Index, ButtonName);
 	}
+
+	// starts loading the descriptor cache, so it is ready before the first device is opened
+	FUnHIDDescriptorCache::Get();
 }
 
 void FUnHIDModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FUnHIDFeaturePollScheduler::Shutdown();
+	FUnHIDDescriptorCache::Shutdown();
+#if PLATFORM_LINUX
+	FUnHIDLinuxReaderService::Shutdown();
+#endif
 }
 
 TSharedPtr<IInputDevice> FUnHIDModule::CreateInputDevice(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler)
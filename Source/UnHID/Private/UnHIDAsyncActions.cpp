@@ -0,0 +1,95 @@
+// Copyright 2026 - Roberto De Ioris
+
+
+#include "UnHIDAsyncActions.h"
+
+UUnHIDGetFeatureReportAsyncAction* UUnHIDGetFeatureReportAsyncAction::UnHIDGetFeatureReportBytesAsyncAction(UObject* WorldContextObject, UUnHIDDevice* UnHIDDevice, const uint8 ReportId, const int32 Size)
+{
+	UUnHIDGetFeatureReportAsyncAction* AsyncAction = NewObject<UUnHIDGetFeatureReportAsyncAction>();
+	AsyncAction->UnHIDDevice = UnHIDDevice;
+	AsyncAction->ReportId = ReportId;
+	AsyncAction->Size = Size;
+	AsyncAction->RegisterWithGameInstance(WorldContextObject);
+	return AsyncAction;
+}
+
+void UUnHIDGetFeatureReportAsyncAction::Activate()
+{
+	if (!UnHIDDevice)
+	{
+		FUnHIDReadResult ReadResult;
+		ReadResult.ErrorMessage = "Invalid UnHIDDevice";
+		OnCompleted(nullptr, ReadResult);
+		return;
+	}
+
+	FUnHIDReadResultNativeDelegate OnReportReceived;
+	OnReportReceived.BindUObject(this, &UUnHIDGetFeatureReportAsyncAction::OnCompleted);
+
+	FString ErrorMessage;
+	if (!UnHIDDevice->GetFeatureReportBytesAsync(ReportId, Size, OnReportReceived, ErrorMessage))
+	{
+		FUnHIDReadResult ReadResult;
+		ReadResult.ErrorMessage = ErrorMessage;
+		OnCompleted(UnHIDDevice, ReadResult);
+	}
+}
+
+void UUnHIDGetFeatureReportAsyncAction::OnCompleted(UUnHIDDevice* InUnHIDDevice, const FUnHIDReadResult& ReadResult)
+{
+	if (ReadResult.bSuccess)
+	{
+		OnSuccess.Broadcast(ReadResult, "");
+	}
+	else
+	{
+		OnFailure.Broadcast(ReadResult, ReadResult.ErrorMessage);
+	}
+
+	SetReadyToDestroy();
+}
+
+UUnHIDSetFeatureReportAsyncAction* UUnHIDSetFeatureReportAsyncAction::UnHIDSetFeatureReportBytesAsyncAction(UObject* WorldContextObject, UUnHIDDevice* UnHIDDevice, const TArray<uint8>& Bytes)
+{
+	UUnHIDSetFeatureReportAsyncAction* AsyncAction = NewObject<UUnHIDSetFeatureReportAsyncAction>();
+	AsyncAction->UnHIDDevice = UnHIDDevice;
+	AsyncAction->Bytes = Bytes;
+	AsyncAction->RegisterWithGameInstance(WorldContextObject);
+	return AsyncAction;
+}
+
+void UUnHIDSetFeatureReportAsyncAction::Activate()
+{
+	if (!UnHIDDevice)
+	{
+		FUnHIDWriteResult WriteResult;
+		WriteResult.ErrorMessage = "Invalid UnHIDDevice";
+		OnCompleted(nullptr, WriteResult);
+		return;
+	}
+
+	FUnHIDWriteNativeDelegate OnWriteCompleted;
+	OnWriteCompleted.BindUObject(this, &UUnHIDSetFeatureReportAsyncAction::OnCompleted);
+
+	FString ErrorMessage;
+	if (!UnHIDDevice->SetFeatureReportBytesAsync(Bytes, OnWriteCompleted, ErrorMessage))
+	{
+		FUnHIDWriteResult WriteResult;
+		WriteResult.ErrorMessage = ErrorMessage;
+		OnCompleted(UnHIDDevice, WriteResult);
+	}
+}
+
+void UUnHIDSetFeatureReportAsyncAction::OnCompleted(UUnHIDDevice* InUnHIDDevice, const FUnHIDWriteResult& WriteResult)
+{
+	if (WriteResult.bSuccess)
+	{
+		OnSuccess.Broadcast(WriteResult, "");
+	}
+	else
+	{
+		OnFailure.Broadcast(WriteResult, WriteResult.ErrorMessage);
+	}
+
+	SetReadyToDestroy();
+}
@@ -0,0 +1,206 @@
+// Copyright 2026 - Roberto De Ioris
+
+#include "UnHIDBitfield.h"
+#include "UnHIDDevice.h"
+
+#if PLATFORM_LITTLE_ENDIAN && defined(__AVX2__)
+#define UNHID_BITFIELD_AVX2 1
+#define UNHID_BITFIELD_NEON 0
+#include <immintrin.h>
+#elif PLATFORM_LITTLE_ENDIAN && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define UNHID_BITFIELD_AVX2 0
+#define UNHID_BITFIELD_NEON 1
+#include <arm_neon.h>
+#else
+#define UNHID_BITFIELD_AVX2 0
+#define UNHID_BITFIELD_NEON 0
+#endif
+
+namespace UnHID
+{
+	// fields up to 57 bits always fit in a single (unaligned) word load
+	constexpr int32 MaxSingleWordBitSize = 57;
+
+	static FORCEINLINE uint64 LoadWord(const uint8* Data)
+	{
+		uint64 Word;
+		FMemory::Memcpy(&Word, Data, sizeof(uint64));
+#if !PLATFORM_LITTLE_ENDIAN
+		Word = BYTESWAP_ORDER64(Word);
+#endif
+		return Word;
+	}
+
+	static FORCEINLINE bool IsSingleWordField(const int64 NumBytes, const int64 BitOffset, const int32 BitSize)
+	{
+		return BitOffset >= 0 && BitSize > 0 && BitSize <= MaxSingleWordBitSize && (BitOffset / 8) + 8 <= NumBytes;
+	}
+
+	static FORCEINLINE uint64 ExtractSingleWordBits(const uint8* Data, const int64 BitOffset, const int32 BitSize)
+	{
+		return (LoadWord(Data + BitOffset / 8) >> (BitOffset % 8)) & ((1ULL << BitSize) - 1);
+	}
+}
+
+uint64 UnHID::ExtractBits(TArrayView<const uint8> Bytes, const int64 BitOffset, const int64 BitSize)
+{
+	if (BitOffset < 0 || BitSize <= 0 || BitSize > 64)
+	{
+		return 0;
+	}
+
+	const int64 FirstByte = BitOffset / 8;
+	if (FirstByte >= Bytes.Num())
+	{
+		return 0;
+	}
+
+	const int32 Shift = static_cast<int32>(BitOffset % 8);
+	const int64 NumAvailableBytes = Bytes.Num() - FirstByte;
+
+	uint64 Value = 0;
+	if (NumAvailableBytes >= 8)
+	{
+		Value = LoadWord(Bytes.GetData() + FirstByte) >> Shift;
+		// a field crossing the word (only for more than 57 bits) takes the high bits from the 9th byte
+		if (Shift > 0 && Shift + BitSize > 64 && NumAvailableBytes > 8)
+		{
+			Value |= static_cast<uint64>(Bytes[FirstByte + 8]) << (64 - Shift);
+		}
+	}
+	else
+	{
+		// tail of the report
+		for (int64 Index = 0; Index < NumAvailableBytes; Index++)
+		{
+			Value |= static_cast<uint64>(Bytes[FirstByte + Index]) << (Index * 8);
+		}
+		Value >>= Shift;
+	}
+
+	return BitSize < 64 ? Value & ((1ULL << BitSize) - 1) : Value;
+}
+
+void UnHID::ExtractBitsBatch(TArrayView<const uint8> Bytes, TArrayView<const int64> BitOffsets, TArrayView<const int32> BitSizes, TArrayView<uint64> Values)
+{
+	const int32 NumFields = FMath::Min3(BitOffsets.Num(), BitSizes.Num(), Values.Num());
+	const uint8* Data = Bytes.GetData();
+	const int64 NumBytes = Bytes.Num();
+
+	int32 Index = 0;
+
+#if UNHID_BITFIELD_AVX2
+	const __m256i Ones = _mm256_set1_epi64x(1);
+	const __m256i ShiftMask = _mm256_set1_epi64x(7);
+	for (; Index + 4 <= NumFields; Index += 4)
+	{
+		// groups with fields at the end of the report (or wider than a word) are left to the scalar kernel
+		if (!IsSingleWordField(NumBytes, BitOffsets[Index], BitSizes[Index]) ||
+			!IsSingleWordField(NumBytes, BitOffsets[Index + 1], BitSizes[Index + 1]) ||
+			!IsSingleWordField(NumBytes, BitOffsets[Index + 2], BitSizes[Index + 2]) ||
+			!IsSingleWordField(NumBytes, BitOffsets[Index + 3], BitSizes[Index + 3]))
+		{
+			for (int32 FieldIndex = Index; FieldIndex < Index + 4; FieldIndex++)
+			{
+				Values[FieldIndex] = ExtractBits(Bytes, BitOffsets[FieldIndex], BitSizes[FieldIndex]);
+			}
+			continue;
+		}
+
+		const __m256i Offsets = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(BitOffsets.GetData() + Index));
+		const __m256i Sizes = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(BitSizes.GetData() + Index)));
+		const __m256i Words = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(Data), _mm256_srli_epi64(Offsets, 3), 1);
+		const __m256i Masks = _mm256_sub_epi64(_mm256_sllv_epi64(Ones, Sizes), Ones);
+		const __m256i Fields = _mm256_and_si256(_mm256_srlv_epi64(Words, _mm256_and_si256(Offsets, ShiftMask)), Masks);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(Values.GetData() + Index), Fields);
+	}
+#elif UNHID_BITFIELD_NEON
+	const uint64x2_t Ones = vdupq_n_u64(1);
+	for (; Index + 2 <= NumFields; Index += 2)
+	{
+		const int64 BitOffset0 = BitOffsets[Index];
+		const int64 BitOffset1 = BitOffsets[Index + 1];
+		if (!IsSingleWordField(NumBytes, BitOffset0, BitSizes[Index]) || !IsSingleWordField(NumBytes, BitOffset1, BitSizes[Index + 1]))
+		{
+			Values[Index] = ExtractBits(Bytes, BitOffset0, BitSizes[Index]);
+			Values[Index + 1] = ExtractBits(Bytes, BitOffset1, BitSizes[Index + 1]);
+			continue;
+		}
+
+		// lanes built from values (uint64 and uint64_t are not the same type on every toolchain)
+		const uint64x2_t Words = vcombine_u64(vcreate_u64(LoadWord(Data + BitOffset0 / 8)), vcreate_u64(LoadWord(Data + BitOffset1 / 8)));
+		// negative shifts are right shifts
+		const int64x2_t Shifts = vcombine_s64(vcreate_s64(static_cast<uint64>(-(BitOffset0 % 8))), vcreate_s64(static_cast<uint64>(-(BitOffset1 % 8))));
+		const int64x2_t Sizes = vcombine_s64(vcreate_s64(static_cast<uint64>(BitSizes[Index])), vcreate_s64(static_cast<uint64>(BitSizes[Index + 1])));
+
+		const uint64x2_t Masks = vsubq_u64(vshlq_u64(Ones, Sizes), Ones);
+		const uint64x2_t Fields = vandq_u64(vshlq_u64(Words, Shifts), Masks);
+		Values[Index] = vgetq_lane_u64(Fields, 0);
+		Values[Index + 1] = vgetq_lane_u64(Fields, 1);
+	}
+#endif
+
+	for (; Index < NumFields; Index++)
+	{
+		if (IsSingleWordField(NumBytes, BitOffsets[Index], BitSizes[Index]))
+		{
+			Values[Index] = ExtractSingleWordBits(Data, BitOffsets[Index], BitSizes[Index]);
+		}
+		else
+		{
+			Values[Index] = ExtractBits(Bytes, BitOffsets[Index], BitSizes[Index]);
+		}
+	}
+}
+
+void UnHID::ExtractBitmask(TArrayView<const uint8> Bytes, const int64 BitOffset, const int64 BitSize, TArray<bool>& Bitmask)
+{
+	Bitmask.Reset();
+
+	if (BitOffset < 0 || BitSize <= 0)
+	{
+		return;
+	}
+
+	const int64 NumBits = FMath::Min<int64>(BitSize, static_cast<int64>(Bytes.Num()) * 8 - BitOffset);
+	if (NumBits <= 0)
+	{
+		return;
+	}
+
+	Bitmask.AddUninitialized(static_cast<int32>(NumBits));
+	bool* Bits = Bitmask.GetData();
+
+	// 64 bits per load
+	for (int64 Index = 0; Index < NumBits; Index += 64)
+	{
+		const int64 NumWordBits = FMath::Min<int64>(64, NumBits - Index);
+		const uint64 Word = ExtractBits(Bytes, BitOffset + Index, NumWordBits);
+		for (int64 BitIndex = 0; BitIndex < NumWordBits; BitIndex++)
+		{
+			Bits[Index + BitIndex] = ((Word >> BitIndex) & 1) != 0;
+		}
+	}
+}
+
+void FUnHIDBitset::SetFromBytes(TArrayView<const uint8> Bytes, const int64 BitOffset, const int32 BitSize)
+{
+	Init(BitSize);
+
+	// 64 bits per load, the last word is masked by ExtractBits
+	for (int32 WordIndex = 0; WordIndex < Words.Num(); WordIndex++)
+	{
+		Words[WordIndex] = static_cast<int64>(UnHID::ExtractBits(Bytes, BitOffset + WordIndex * 64, FMath::Min(64, NumBits - WordIndex * 64)));
+	}
+}
+
+const TCHAR* UnHID::GetExtractBitsBatchKernelName()
+{
+#if UNHID_BITFIELD_AVX2
+	return TEXT("AVX2");
+#elif UNHID_BITFIELD_NEON
+	return TEXT("NEON");
+#else
+	return TEXT("Scalar");
+#endif
+}
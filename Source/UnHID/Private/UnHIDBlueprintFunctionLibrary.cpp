@@ -7,6 +7,7 @@ THIRD_PARTY_INCLUDES_START
 #include "hidapi.h"
 THIRD_PARTY_INCLUDES_END
 
+#include "UnHIDBitfield.h"
 #include "UnHID.h"
 #include "UnHIDDevice.h"
 
@@ -280,12 +281,11 @@ FString UUnHIDBlueprintFunctionLibrary::UnHIDBytesToHexString(const TArray<uint8
 
 UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDevice(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadDynamicDelegate& InUnHIDReadDynamicDelegate, FString& ErrorMessage)
 {
-	UUnHIDDevice* UnHIDDevice = NewObject<UUnHIDDevice>();
-	if (!UnHIDDevice)
-	{
-		return nullptr;
-	}
+	return UnHIDOpenDeviceWithReadOptions(UnHIDDeviceInfo, FUnHIDDeviceReadOptions(), InUnHIDReadDynamicDelegate, ErrorMessage);
+}
 
+UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDeviceWithReadOptions(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& ReadOptions, const FUnHIDReadDynamicDelegate& InUnHIDReadDynamicDelegate, FString& ErrorMessage)
+{
 	FUnHIDReadNativeDelegate UnHIDReadNativeDelegate;
 
 	UnHIDReadNativeDelegate.BindLambda([InUnHIDReadDynamicDelegate](UUnHIDDevice* UnHIDDevice, const TArray<uint8>& Data, const FString& ErrorMessage)
@@ -293,12 +293,24 @@ UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDevice(const FUnHIDDevice
 			InUnHIDReadDynamicDelegate.ExecuteIfBound(UnHIDDevice, Data, ErrorMessage);
 		});
 
-	if (!UnHIDDevice->Initialize(UnHIDDeviceInfo, UnHIDReadNativeDelegate, ErrorMessage))
-	{
-		return nullptr;
-	}
+	return UnHIDOpenDeviceWithReadOptions(UnHIDDeviceInfo, ReadOptions, UnHIDReadNativeDelegate, ErrorMessage);
+}
 
-	return UnHIDDevice;
+UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDeviceWithTimestamp(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadWithTimestampDynamicDelegate& InUnHIDReadWithTimestampDynamicDelegate, FString& ErrorMessage)
+{
+	return UnHIDOpenDeviceWithReadOptionsWithTimestamp(UnHIDDeviceInfo, FUnHIDDeviceReadOptions(), InUnHIDReadWithTimestampDynamicDelegate, ErrorMessage);
+}
+
+UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDeviceWithReadOptionsWithTimestamp(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& ReadOptions, const FUnHIDReadWithTimestampDynamicDelegate& InUnHIDReadWithTimestampDynamicDelegate, FString& ErrorMessage)
+{
+	FUnHIDReadWithTimestampNativeDelegate UnHIDReadWithTimestampNativeDelegate;
+
+	UnHIDReadWithTimestampNativeDelegate.BindLambda([InUnHIDReadWithTimestampDynamicDelegate](UUnHIDDevice* UnHIDDevice, const TArray<uint8>& Data, const int64 Timestamp, const FString& ErrorMessage)
+		{
+			InUnHIDReadWithTimestampDynamicDelegate.ExecuteIfBound(UnHIDDevice, Data, Timestamp, ErrorMessage);
+		});
+
+	return UnHIDOpenDeviceWithReadOptionsWithTimestamp(UnHIDDeviceInfo, ReadOptions, UnHIDReadWithTimestampNativeDelegate, ErrorMessage);
 }
 
 UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDeviceByUsageFilter(const int32 UsagePage, const int32 Usage, const FUnHIDReadDynamicDelegate& InUnHIDReadDynamicDelegate, FString& ErrorMessage)
@@ -346,6 +358,86 @@ TArray<UUnHIDDevice*> UUnHIDBlueprintFunctionLibrary::UnHIDOpenDevicesByUsageFil
 }
 
 UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDevice(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadNativeDelegate& InUnHIDReadNativeDelegate, FString& ErrorMessage)
+{
+	return UnHIDOpenDeviceWithReadOptions(UnHIDDeviceInfo, FUnHIDDeviceReadOptions(), InUnHIDReadNativeDelegate, ErrorMessage);
+}
+
+UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDeviceWithReadOptions(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& ReadOptions, const FUnHIDReadNativeDelegate& InUnHIDReadNativeDelegate, FString& ErrorMessage)
+{
+	UUnHIDDevice* UnHIDDevice = NewObject<UUnHIDDevice>();
+	if (!UnHIDDevice)
+	{
+		return nullptr;
+	}
+
+	if (!UnHIDDevice->Initialize(UnHIDDeviceInfo, ReadOptions, InUnHIDReadNativeDelegate, ErrorMessage))
+	{
+		return nullptr;
+	}
+
+	return UnHIDDevice;
+}
+
+UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDeviceWithTimestamp(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadWithTimestampNativeDelegate& InUnHIDReadWithTimestampNativeDelegate, FString& ErrorMessage)
+{
+	return UnHIDOpenDeviceWithReadOptionsWithTimestamp(UnHIDDeviceInfo, FUnHIDDeviceReadOptions(), InUnHIDReadWithTimestampNativeDelegate, ErrorMessage);
+}
+
+UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDeviceWithReadOptionsWithTimestamp(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& ReadOptions, const FUnHIDReadWithTimestampNativeDelegate& InUnHIDReadWithTimestampNativeDelegate, FString& ErrorMessage)
+{
+	UUnHIDDevice* UnHIDDevice = NewObject<UUnHIDDevice>();
+	if (!UnHIDDevice)
+	{
+		return nullptr;
+	}
+
+	if (!UnHIDDevice->Initialize(UnHIDDeviceInfo, ReadOptions, InUnHIDReadWithTimestampNativeDelegate, ErrorMessage))
+	{
+		return nullptr;
+	}
+
+	return UnHIDDevice;
+}
+
+UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDeviceBatched(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadBatchDynamicDelegate& InUnHIDReadBatchDynamicDelegate, FString& ErrorMessage)
+{
+	return UnHIDOpenDeviceBatchedWithReadOptions(UnHIDDeviceInfo, FUnHIDDeviceReadOptions(), InUnHIDReadBatchDynamicDelegate, ErrorMessage);
+}
+
+UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDeviceBatchedWithReadOptions(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& ReadOptions, const FUnHIDReadBatchDynamicDelegate& InUnHIDReadBatchDynamicDelegate, FString& ErrorMessage)
+{
+	FUnHIDReadBatchNativeDelegate UnHIDReadBatchNativeDelegate;
+
+	UnHIDReadBatchNativeDelegate.BindLambda([InUnHIDReadBatchDynamicDelegate](UUnHIDDevice* UnHIDDevice, const FUnHIDReportBatch& ReportBatch, const FString& ErrorMessage)
+		{
+			InUnHIDReadBatchDynamicDelegate.ExecuteIfBound(UnHIDDevice, ReportBatch, ErrorMessage);
+		});
+
+	return UnHIDOpenDeviceBatchedWithReadOptions(UnHIDDeviceInfo, ReadOptions, UnHIDReadBatchNativeDelegate, ErrorMessage);
+}
+
+UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDeviceBatched(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadBatchNativeDelegate& InUnHIDReadBatchNativeDelegate, FString& ErrorMessage)
+{
+	return UnHIDOpenDeviceBatchedWithReadOptions(UnHIDDeviceInfo, FUnHIDDeviceReadOptions(), InUnHIDReadBatchNativeDelegate, ErrorMessage);
+}
+
+UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDeviceBatchedWithReadOptions(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& ReadOptions, const FUnHIDReadBatchNativeDelegate& InUnHIDReadBatchNativeDelegate, FString& ErrorMessage)
+{
+	UUnHIDDevice* UnHIDDevice = NewObject<UUnHIDDevice>();
+	if (!UnHIDDevice)
+	{
+		return nullptr;
+	}
+
+	if (!UnHIDDevice->Initialize(UnHIDDeviceInfo, ReadOptions, InUnHIDReadBatchNativeDelegate, ErrorMessage))
+	{
+		return nullptr;
+	}
+
+	return UnHIDDevice;
+}
+
+UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDeviceAnyThread(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadAnyThreadNativeDelegate& InUnHIDReadAnyThreadNativeDelegate, FString& ErrorMessage)
 {
 	UUnHIDDevice* UnHIDDevice = NewObject<UUnHIDDevice>();
 	if (!UnHIDDevice)
@@ -353,7 +445,7 @@ UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDevice(const FUnHIDDevice
 		return nullptr;
 	}
 
-	if (!UnHIDDevice->Initialize(UnHIDDeviceInfo, InUnHIDReadNativeDelegate, ErrorMessage))
+	if (!UnHIDDevice->Initialize(UnHIDDeviceInfo, InUnHIDReadAnyThreadNativeDelegate, ErrorMessage))
 	{
 		return nullptr;
 	}
@@ -361,6 +453,44 @@ UUnHIDDevice* UUnHIDBlueprintFunctionLibrary::UnHIDOpenDevice(const FUnHIDDevice
 	return UnHIDDevice;
 }
 
+TArray<uint8> UUnHIDBlueprintFunctionLibrary::UnHIDGetReportFromReportBatch(const FUnHIDReportBatch& ReportBatch, const int32 Index)
+{
+	if (!ReportBatch.Sizes.IsValidIndex(Index) || !ReportBatch.Offsets.IsValidIndex(Index))
+	{
+		return TArray<uint8>();
+	}
+
+	const int32 Offset = ReportBatch.Offsets[Index];
+	const int32 Size = ReportBatch.Sizes[Index];
+	if (Offset < 0 || Size < 0 || Offset + Size > ReportBatch.Data.Num())
+	{
+		return TArray<uint8>();
+	}
+
+	return TArray<uint8>(ReportBatch.Data.GetData() + Offset, Size);
+}
+
+int64 UUnHIDBlueprintFunctionLibrary::UnHIDGetTimestampNow()
+{
+	return static_cast<int64>(FPlatformTime::Cycles64());
+}
+
+double UUnHIDBlueprintFunctionLibrary::UnHIDTimestampToSeconds(const int64 Timestamp)
+{
+	return FPlatformTime::ToSeconds64(static_cast<uint64>(Timestamp));
+}
+
+double UUnHIDBlueprintFunctionLibrary::UnHIDTimestampsDeltaToMilliseconds(const int64 FromTimestamp, const int64 ToTimestamp)
+{
+	// signed, the timestamps could be in any order
+	return static_cast<double>(ToTimestamp - FromTimestamp) * FPlatformTime::GetSecondsPerCycle64() * 1000.0;
+}
+
+bool UUnHIDBlueprintFunctionLibrary::UnHIDMatchBytesWithMask(const TArray<uint8>& Bytes, const TArray<uint8>& Pattern, const TArray<uint8>& Mask)
+{
+	return UnHID::MatchBytesWithMask(Bytes, Pattern, Mask);
+}
+
 TArray<uint8> UUnHIDBlueprintFunctionLibrary::UnHIDHexStringToBytes(const FString& HexString)
 {
 	TArray<uint8> OutputBytes;
@@ -770,49 +900,68 @@ TArray<bool> UUnHIDBlueprintFunctionLibrary::UnHIDParseBitmaskFromBytes(const TA
 {
 	TArray<bool> Bitmask;
 
-	for (int64 Index = 0; Index < BitSize; Index++)
-	{
-		const uint64 BitIndex = BitOffset + Index;
-		const uint64 ByteIndex = BitIndex / 8;
-		const uint64 BitInByte = BitIndex % 8;
+	UnHID::ExtractBitmask(Bytes, BitOffset, BitSize, Bitmask);
 
-		if (!Bytes.IsValidIndex(ByteIndex))
-		{
-			break;
-		}
+	return Bitmask;
+}
 
-		const uint8 Bit = (Bytes[ByteIndex] >> BitInByte) & 1;
-		Bitmask.Add(Bit == 1);
-	}
+FUnHIDBitset UUnHIDBlueprintFunctionLibrary::UnHIDParseBitsetFromBytes(const TArray<uint8>& Bytes, const int64 BitOffset, const int32 BitSize)
+{
+	FUnHIDBitset Bitset;
 
-	return Bitmask;
+	Bitset.SetFromBytes(Bytes, BitOffset, BitSize);
+
+	return Bitset;
 }
 
-int64 UUnHIDBlueprintFunctionLibrary::UnHIDParseUnsignedIntegerFromBytes(const TArray<uint8>& Bytes, const int64 BitOffset, const int64 BitSize)
+bool UUnHIDBlueprintFunctionLibrary::UnHIDBitsetIsSet(const FUnHIDBitset& Bitset, const int32 Index)
 {
-	if (BitOffset < 0 || BitSize <= 0 || BitSize > 64)
-	{
-		return 0;
-	}
+	return Bitset.IsSet(Index);
+}
 
-	uint64 Value = 0;
+int32 UUnHIDBlueprintFunctionLibrary::UnHIDBitsetCountSetBits(const FUnHIDBitset& Bitset)
+{
+	return Bitset.CountSetBits();
+}
 
-	for (int64 Index = 0; Index < BitSize; Index++)
-	{
-		const uint64 BitIndex = BitOffset + Index;
-		const uint64 ByteIndex = BitIndex / 8;
-		const uint64 BitInByte = BitIndex % 8;
+TArray<int32> UUnHIDBlueprintFunctionLibrary::UnHIDBitsetGetSetBits(const FUnHIDBitset& Bitset)
+{
+	TArray<int32> SetBits;
+	SetBits.Reserve(Bitset.CountSetBits());
 
-		if (!Bytes.IsValidIndex(ByteIndex))
+	Bitset.ForEachSetBit([&SetBits](const int32 Index)
 		{
-			break;
-		}
+			SetBits.Add(Index);
+		});
 
-		const uint64 Bit = (Bytes[ByteIndex] >> BitInByte) & 1;
-		Value |= (Bit << Index);
+	return SetBits;
+}
+
+FUnHIDBitset UUnHIDBlueprintFunctionLibrary::UnHIDBitsetXor(const FUnHIDBitset& Bitset, const FUnHIDBitset& Previous)
+{
+	FUnHIDBitset ChangedBits;
+
+	Bitset.Xor(Previous, ChangedBits);
+
+	return ChangedBits;
+}
+
+TArray<bool> UUnHIDBlueprintFunctionLibrary::UnHIDBitsetToBitmask(const FUnHIDBitset& Bitset)
+{
+	TArray<bool> Bitmask;
+	Bitmask.AddUninitialized(Bitset.NumBits);
+
+	for (int32 Index = 0; Index < Bitset.NumBits; Index++)
+	{
+		Bitmask[Index] = Bitset.IsSet(Index);
 	}
 
-	return Value;
+	return Bitmask;
+}
+
+int64 UUnHIDBlueprintFunctionLibrary::UnHIDParseUnsignedIntegerFromBytes(const TArray<uint8>& Bytes, const int64 BitOffset, const int64 BitSize)
+{
+	return static_cast<int64>(UnHID::ExtractBits(Bytes, BitOffset, BitSize));
 }
 
 int64 UUnHIDBlueprintFunctionLibrary::UnHIDParseSignedIntegerFromBytes(const TArray<uint8>& Bytes, const int64 BitOffset, const int64 BitSize)
@@ -0,0 +1,126 @@
+// Copyright 2026 - Roberto De Ioris
+
+#include "UnHIDBulkTransfer.h"
+#include "Async/Async.h"
+#include "HAL/RunnableThread.h"
+#include "UnHIDResponseMatcher.h"
+
+FUnHIDBulkTransfer::FUnHIDBulkTransfer(UUnHIDDevice* InDevice, FUnHIDResponseMatcher* InResponseMatcher, const TArray<uint8>& InData, const FUnHIDBulkTransferOptions& InBulkTransferOptions, const int32 InFrameSize, const FUnHIDBulkTransferNativeDelegate& InOnBulkTransferCompleted) :
+	Frames(InData, InBulkTransferOptions, InFrameSize),
+	bStopThread(false),
+	bCompleted(false),
+	PendingAckId(0)
+{
+	Device = InDevice;
+	WeakDevice = InDevice;
+	ResponseMatcher = InResponseMatcher;
+	BulkTransferOptions = InBulkTransferOptions;
+	OnBulkTransferCompleted = InOnBulkTransferCompleted;
+
+	AckPredicate.BindLambda([AckPattern = BulkTransferOptions.AckPattern, AckMask = BulkTransferOptions.AckMask](TArrayView<const uint8> Report)
+		{
+			return UnHID::MatchBytesWithMask(Report, AckPattern, AckMask);
+		});
+
+	Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("UnHIDBulkTransfer@%p"), this));
+}
+
+FUnHIDBulkTransfer::~FUnHIDBulkTransfer()
+{
+	Stop();
+	if (Thread)
+	{
+		Thread->WaitForCompletion();
+		delete Thread;
+	}
+
+	Thread = nullptr;
+}
+
+void FUnHIDBulkTransfer::GetBulkTransferStats(FUnHIDBulkTransferStats& BulkTransferStats) const
+{
+	Frames.GetStats(BulkTransferStats);
+}
+
+uint32 FUnHIDBulkTransfer::Run()
+{
+	FString ErrorMessage;
+	const bool bSuccess = Frames.Send([this](const TArray<uint8>& Frame, const bool bAwaitAck, FString& FrameErrorMessage)
+		{
+			return bAwaitAck ? SendAcknowledgedFrame(Frame, FrameErrorMessage) : SendFrame(Frame, FrameErrorMessage);
+		}, bStopThread, ErrorMessage);
+
+	FUnHIDBulkTransferStats CompletedStats;
+	Frames.Complete(bSuccess, ErrorMessage, CompletedStats);
+
+	bCompleted = true;
+
+	AsyncTask(ENamedThreads::GameThread, [WeakDevice = WeakDevice, OnBulkTransferCompleted = OnBulkTransferCompleted, CompletedStats]()
+		{
+			OnBulkTransferCompleted.ExecuteIfBound(WeakDevice.Get(), CompletedStats);
+		});
+
+	return 0;
+}
+
+void FUnHIDBulkTransfer::Stop()
+{
+	bStopThread = true;
+
+	// wakes up the acknowledgement wait (a stale id is simply ignored by the matcher)
+	const uint64 PendingResponseId = PendingAckId;
+	if (PendingResponseId != 0)
+	{
+		ResponseMatcher->Fail(PendingResponseId, "Cancelled");
+	}
+}
+
+bool FUnHIDBulkTransfer::SendFrame(const TArray<uint8>& Frame, FString& ErrorMessage)
+{
+	// both are serialized with the other device accesses
+	if (BulkTransferOptions.bFeatureReports)
+	{
+		return Device->SetFeatureReportBytes(Frame, ErrorMessage);
+	}
+
+	return Device->WriteBytes(Frame, ErrorMessage);
+}
+
+bool FUnHIDBulkTransfer::SendAcknowledgedFrame(const TArray<uint8>& Frame, FString& ErrorMessage)
+{
+	TOptional<TPromise<FUnHIDReadResult>> Promise;
+	Promise.Emplace();
+	TFuture<FUnHIDReadResult> Future = Promise->GetFuture();
+
+	const uint64 Now = FPlatformTime::Cycles64();
+	// registered before writing, so even the fastest acknowledgement is matched
+	const uint64 PendingResponseId = ResponseMatcher->Add(AckPredicate, Now, BulkTransferOptions.AckTimeoutSeconds, FUnHIDReadResultNativeDelegate(), MoveTemp(Promise));
+	if (!SendFrame(Frame, ErrorMessage))
+	{
+		ResponseMatcher->Fail(PendingResponseId, ErrorMessage);
+		return false;
+	}
+
+	// Stop() fails the pending acknowledgement, so a single wait is enough
+	PendingAckId = PendingResponseId;
+	if (bStopThread)
+	{
+		ResponseMatcher->Fail(PendingResponseId, "Cancelled");
+	}
+
+	const double ElapsedSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Now);
+	if (!Future.WaitFor(FTimespan::FromSeconds(FMath::Max(BulkTransferOptions.AckTimeoutSeconds - ElapsedSeconds, 0.0))))
+	{
+		ResponseMatcher->Fail(PendingResponseId, "Acknowledgement timeout");
+	}
+	PendingAckId = 0;
+
+	const FUnHIDReadResult& AckResult = Future.Get();
+	if (!AckResult.bSuccess)
+	{
+		ErrorMessage = AckResult.ErrorMessage;
+		return false;
+	}
+
+	return true;
+}
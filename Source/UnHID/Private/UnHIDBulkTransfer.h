@@ -0,0 +1,54 @@
+// Copyright 2026 - Roberto De Ioris
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "UnHIDBulkTransferFrames.h"
+
+/**
+ * Large payload split in report sized frames and sent (output or feature reports) by a dedicated thread.
+ * With acknowledgement windows the last frame of each window waits for a matching input report, a window
+ * not acknowledged in time is sent again (framing and retries are in FUnHIDBulkTransferFrames).
+ */
+class FUnHIDBulkTransfer : public FRunnable
+{
+public:
+	// InFrameSize is the payload of each frame (the report id is prefixed)
+	FUnHIDBulkTransfer(UUnHIDDevice* InDevice, class FUnHIDResponseMatcher* InResponseMatcher, const TArray<uint8>& InData, const FUnHIDBulkTransferOptions& InBulkTransferOptions, const int32 InFrameSize, const FUnHIDBulkTransferNativeDelegate& InOnBulkTransferCompleted);
+	// cancels the transfer and waits for the thread
+	virtual ~FUnHIDBulkTransfer();
+
+	void GetBulkTransferStats(FUnHIDBulkTransferStats& BulkTransferStats) const;
+
+	bool IsCompleted() const
+	{
+		return bCompleted;
+	}
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	bool SendFrame(const TArray<uint8>& Frame, FString& ErrorMessage);
+	// waits for the acknowledgement
+	bool SendAcknowledgedFrame(const TArray<uint8>& Frame, FString& ErrorMessage);
+
+	UUnHIDDevice* Device;
+	TWeakObjectPtr<UUnHIDDevice> WeakDevice;
+	class FUnHIDResponseMatcher* ResponseMatcher;
+
+	FUnHIDBulkTransferOptions BulkTransferOptions;
+	FUnHIDBulkTransferFrames Frames;
+	FUnHIDBulkTransferNativeDelegate OnBulkTransferCompleted;
+
+	FRunnableThread* Thread = nullptr;
+	TAtomic<bool> bStopThread;
+	TAtomic<bool> bCompleted;
+	// the acknowledgement the transfer thread is waiting for (0 if none), failed by Stop()
+	TAtomic<uint64> PendingAckId;
+
+	// transfer thread only
+	FUnHIDResponsePredicate AckPredicate;
+};
@@ -0,0 +1,130 @@
+// Copyright 2026 - Roberto De Ioris
+
+#include "UnHIDBulkTransferFrames.h"
+
+FUnHIDBulkTransferFrames::FUnHIDBulkTransferFrames(const TArray<uint8>& InData, const FUnHIDBulkTransferOptions& InBulkTransferOptions, const int32 InFrameSize)
+{
+	Data = InData;
+	BulkTransferOptions = InBulkTransferOptions;
+	FrameSize = FMath::Max(InFrameSize, 1);
+	NumFrames = (Data.Num() + FrameSize - 1) / FrameSize;
+
+	Stats.TotalBytes = Data.Num();
+}
+
+void FUnHIDBulkTransferFrames::BuildFrame(const int32 FrameIndex, TArray<uint8>& Frame) const
+{
+	const int32 Offset = FrameIndex * FrameSize;
+	const int32 Size = FMath::Clamp(Data.Num() - Offset, 0, FrameSize);
+
+	// no allocations when the same buffer is used for every frame
+	Frame.SetNumUninitialized(FrameSize + 1);
+	Frame[0] = BulkTransferOptions.ReportId;
+	FMemory::Memcpy(Frame.GetData() + 1, Data.GetData() + Offset, Size);
+	if (Size < FrameSize)
+	{
+		FMemory::Memzero(Frame.GetData() + 1 + Size, FrameSize - Size);
+	}
+}
+
+bool FUnHIDBulkTransferFrames::Send(FSendFrameFunction SendFrame, const TAtomic<bool>& bCancelled, FString& ErrorMessage)
+{
+	StartCycles = FPlatformTime::Cycles64();
+
+	// without acknowledgements the whole payload is a single window
+	const int32 WindowSize = BulkTransferOptions.WindowSize > 0 ? BulkTransferOptions.WindowSize : NumFrames;
+
+	for (int32 FirstFrame = 0; FirstFrame < NumFrames; FirstFrame += WindowSize)
+	{
+		const int32 NumWindowFrames = FMath::Min(WindowSize, NumFrames - FirstFrame);
+		for (int32 Attempt = 0; ; Attempt++)
+		{
+			if (SendWindow(SendFrame, bCancelled, FirstFrame, NumWindowFrames, ErrorMessage))
+			{
+				break;
+			}
+
+			// without acknowledgements the frames have already been retried
+			if (bCancelled || BulkTransferOptions.WindowSize <= 0 || Attempt >= BulkTransferOptions.MaxRetries)
+			{
+				return false;
+			}
+
+			FScopeLock Lock(&StatsLock);
+			Stats.Retries++;
+		}
+
+		UpdateProgress(FirstFrame + NumWindowFrames);
+	}
+
+	return true;
+}
+
+bool FUnHIDBulkTransferFrames::SendWindow(FSendFrameFunction SendFrame, const TAtomic<bool>& bCancelled, const int32 FirstFrame, const int32 NumWindowFrames, FString& ErrorMessage)
+{
+	const bool bAcknowledged = BulkTransferOptions.WindowSize > 0;
+
+	for (int32 FrameIndex = FirstFrame; FrameIndex < FirstFrame + NumWindowFrames; FrameIndex++)
+	{
+		if (bCancelled)
+		{
+			ErrorMessage = "Cancelled";
+			return false;
+		}
+
+		BuildFrame(FrameIndex, FrameBuffer);
+
+		// the acknowledgement is awaited after the last frame of the window
+		const bool bAwaitAck = bAcknowledged && FrameIndex == FirstFrame + NumWindowFrames - 1;
+
+		// without acknowledgements a single frame is sent again on failure
+		bool bFrameSent = SendFrame(FrameBuffer, bAwaitAck, ErrorMessage);
+		for (int32 Retry = 0; !bFrameSent && !bAcknowledged && !bCancelled && Retry < BulkTransferOptions.MaxRetries; Retry++)
+		{
+			{
+				FScopeLock Lock(&StatsLock);
+				Stats.Retries++;
+			}
+			bFrameSent = SendFrame(FrameBuffer, bAwaitAck, ErrorMessage);
+		}
+
+		if (!bFrameSent)
+		{
+			return false;
+		}
+
+		if (!bAcknowledged)
+		{
+			UpdateProgress(FrameIndex + 1);
+		}
+	}
+
+	return true;
+}
+
+void FUnHIDBulkTransferFrames::UpdateProgress(const int32 SentFrames)
+{
+	const double ElapsedSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+	FScopeLock Lock(&StatsLock);
+	Stats.SentFrames = SentFrames;
+	Stats.SentBytes = FMath::Min<int64>(static_cast<int64>(SentFrames) * FrameSize, Data.Num());
+	Stats.Progress = Data.Num() > 0 ? static_cast<float>(static_cast<double>(Stats.SentBytes) / Data.Num()) : 1.0f;
+	Stats.BytesPerSecond = ElapsedSeconds > 0 ? Stats.SentBytes / ElapsedSeconds : 0;
+}
+
+void FUnHIDBulkTransferFrames::Complete(const bool bSuccess, const FString& ErrorMessage, FUnHIDBulkTransferStats& CompletedStats)
+{
+	FScopeLock Lock(&StatsLock);
+	Stats.bCompleted = true;
+	Stats.bSuccess = bSuccess;
+	Stats.ErrorMessage = ErrorMessage;
+	CompletedStats = Stats;
+}
+
+void FUnHIDBulkTransferFrames::GetStats(FUnHIDBulkTransferStats& BulkTransferStats) const
+{
+	FScopeLock Lock(&StatsLock);
+
+	BulkTransferStats = Stats;
+}
@@ -0,0 +1,514 @@
+// Copyright 2026 - Roberto De Ioris
+
+#include "UnHIDDescriptorCache.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UnHIDBlueprintFunctionLibrary.h"
+
+namespace UnHID
+{
+	static FCriticalSection DescriptorCacheLock;
+	static TUniquePtr<FUnHIDDescriptorCache> DescriptorCache;
+
+	constexpr uint32 DescriptorCacheMagic = 0x43444855; // "UHDC"
+	// bump it whenever the descriptor parser (or the format) changes, old files are discarded
+	constexpr int64 DescriptorCacheVersion = 2;
+
+	static uint64 GetReportDescriptorHash(TArrayView<const uint8> ReportDescriptor)
+	{
+		return CityHash64(reinterpret_cast<const char*>(ReportDescriptor.GetData()), ReportDescriptor.Num());
+	}
+
+	// zigzag varint, most of the descriptor values fit in a single byte
+	static void SerializeCompactInt(FArchive& Archive, int64& Value)
+	{
+		if (Archive.IsLoading())
+		{
+			uint64 ZigZag = 0;
+			for (int32 Shift = 0; Shift < 64; Shift += 7)
+			{
+				uint8 Byte = 0;
+				Archive << Byte;
+				if (Archive.IsError())
+				{
+					return;
+				}
+				ZigZag |= static_cast<uint64>(Byte & 0x7F) << Shift;
+				if (!(Byte & 0x80))
+				{
+					break;
+				}
+			}
+			Value = static_cast<int64>(ZigZag >> 1) ^ -static_cast<int64>(ZigZag & 1);
+			return;
+		}
+
+		uint64 ZigZag = (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63);
+		do
+		{
+			uint8 Byte = static_cast<uint8>(ZigZag & 0x7F);
+			ZigZag >>= 7;
+			if (ZigZag)
+			{
+				Byte |= 0x80;
+			}
+			Archive << Byte;
+		} while (ZigZag);
+	}
+
+	static void SerializeCompactInt(FArchive& Archive, int32& Value)
+	{
+		int64 Value64 = Value;
+		SerializeCompactInt(Archive, Value64);
+		Value = static_cast<int32>(Value64);
+	}
+
+	// returns false for corrupted counts (every element takes at least one byte)
+	static bool SerializeCompactNum(FArchive& Archive, int32& Num)
+	{
+		SerializeCompactInt(Archive, Num);
+		if (Archive.IsLoading() && (Num < 0 || Num > Archive.TotalSize() - Archive.Tell()))
+		{
+			Archive.SetError();
+		}
+		return !Archive.IsError();
+	}
+
+	static void SerializeCompactIntArray(FArchive& Archive, TArray<int64>& Values)
+	{
+		int32 Num = Values.Num();
+		if (!SerializeCompactNum(Archive, Num))
+		{
+			return;
+		}
+
+		Values.SetNum(Num);
+		for (int64& Value : Values)
+		{
+			SerializeCompactInt(Archive, Value);
+		}
+	}
+
+	// the layouts are handed to the decoders, so an item must never address bits outside of its report
+	static bool IsValidDescriptorReports(const TArray<FUnHIDDeviceDescriptorReport>& DescriptorReports)
+	{
+		for (const FUnHIDDeviceDescriptorReport& DescriptorReport : DescriptorReports)
+		{
+			if (DescriptorReport.ReportId < 0 || DescriptorReport.ReportId > 255 || DescriptorReport.NumBits < 0 || DescriptorReport.NumBytes != (DescriptorReport.NumBits + 7) / 8)
+			{
+				return false;
+			}
+
+			for (const FUnHIDDeviceDescriptorReportItem& Item : DescriptorReport.Items)
+			{
+				if (Item.BitOffset < 0 || Item.BitSize < 0 || Item.Count < 0 || Item.BitOffset > DescriptorReport.NumBits)
+				{
+					return false;
+				}
+
+				// BitOffset + BitSize * Count <= NumBits without overflowing
+				if (Item.BitSize > 0 && Item.Count > (DescriptorReport.NumBits - Item.BitOffset) / Item.BitSize)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	static void SerializeDescriptorReports(FArchive& Archive, TArray<FUnHIDDeviceDescriptorReport>& DescriptorReports)
+	{
+		int32 NumReports = DescriptorReports.Num();
+		if (!SerializeCompactNum(Archive, NumReports))
+		{
+			return;
+		}
+
+		DescriptorReports.SetNum(NumReports);
+		for (FUnHIDDeviceDescriptorReport& DescriptorReport : DescriptorReports)
+		{
+			SerializeCompactInt(Archive, DescriptorReport.ReportId);
+			SerializeCompactInt(Archive, DescriptorReport.NumBits);
+			SerializeCompactInt(Archive, DescriptorReport.NumBytes);
+
+			int32 NumItems = DescriptorReport.Items.Num();
+			if (!SerializeCompactNum(Archive, NumItems))
+			{
+				return;
+			}
+
+			DescriptorReport.Items.SetNum(NumItems);
+			for (FUnHIDDeviceDescriptorReportItem& Item : DescriptorReport.Items)
+			{
+				SerializeCompactInt(Archive, Item.BitOffset);
+				SerializeCompactInt(Archive, Item.BitSize);
+				SerializeCompactInt(Archive, Item.Count);
+				SerializeCompactInt(Archive, Item.UsagePage);
+				SerializeCompactIntArray(Archive, Item.Usage);
+				SerializeCompactInt(Archive, Item.UsageMinimum);
+				SerializeCompactInt(Archive, Item.UsageMaximum);
+				SerializeCompactInt(Archive, Item.LogicalMinimum);
+				SerializeCompactInt(Archive, Item.LogicalMaximum);
+				SerializeCompactInt(Archive, Item.PhysicalMinimum);
+				SerializeCompactInt(Archive, Item.PhysicalMaximum);
+				SerializeCompactInt(Archive, Item.UnitExponent);
+				SerializeCompactInt(Archive, Item.Unit);
+				SerializeCompactIntArray(Archive, Item.CollectionUsage);
+			}
+		}
+	}
+}
+
+FUnHIDDescriptorCache& FUnHIDDescriptorCache::Get()
+{
+	FScopeLock Lock(&UnHID::DescriptorCacheLock);
+
+	if (!UnHID::DescriptorCache)
+	{
+		UnHID::DescriptorCache = TUniquePtr<FUnHIDDescriptorCache>(new FUnHIDDescriptorCache());
+	}
+
+	return *UnHID::DescriptorCache;
+}
+
+void FUnHIDDescriptorCache::Shutdown()
+{
+	FScopeLock Lock(&UnHID::DescriptorCacheLock);
+
+	UnHID::DescriptorCache.Reset();
+}
+
+FUnHIDDescriptorCache::FUnHIDDescriptorCache()
+{
+	Filename = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnHID"), TEXT("DescriptorCache.bin"));
+
+	// the cache is empty until the file has been loaded (devices opened in the meantime are just parsed)
+	LoadTask = Async(EAsyncExecution::ThreadPool, [this]()
+		{
+			Load();
+		});
+}
+
+FUnHIDDescriptorCache::~FUnHIDDescriptorCache()
+{
+	// the load can schedule a save
+	LoadTask.Wait();
+
+	for (TFuture<void>& PendingSave : PendingSaves)
+	{
+		PendingSave.Wait();
+	}
+}
+
+bool FUnHIDDescriptorCache::FindReportDescriptor(const FUnHIDDeviceInfo& DeviceInfo, TArray<uint8>& ReportDescriptor, TSharedPtr<const FUnHIDDeviceDescriptorReports>& DescriptorReports)
+{
+	FScopeLock Lock(&EntriesLock);
+
+	const FUnHIDDescriptorCacheEntry* Entry = FindEntry(DeviceInfo);
+	if (!Entry)
+	{
+		return false;
+	}
+
+	ReportDescriptor = Entry->ReportDescriptor;
+	DescriptorReports = Entry->DescriptorReports;
+	return true;
+}
+
+TSharedPtr<const FUnHIDDeviceDescriptorReports> FUnHIDDescriptorCache::FindDescriptorReports(const FUnHIDDeviceInfo& DeviceInfo, TArrayView<const uint8> ReportDescriptor)
+{
+	const uint64 ReportDescriptorHash = UnHID::GetReportDescriptorHash(ReportDescriptor);
+
+	FScopeLock Lock(&EntriesLock);
+
+	const FUnHIDDescriptorCacheEntry* Entry = FindEntry(DeviceInfo);
+	if (!Entry || Entry->ReportDescriptorHash != ReportDescriptorHash || Entry->ReportDescriptor.Num() != ReportDescriptor.Num())
+	{
+		return nullptr;
+	}
+
+	return Entry->DescriptorReports;
+}
+
+TSharedPtr<const FUnHIDDeviceDescriptorReports> FUnHIDDescriptorCache::GetOrParseDescriptorReports(const FUnHIDDeviceInfo& DeviceInfo, const TArray<uint8>& ReportDescriptor, FString& ErrorMessage)
+{
+	if (TSharedPtr<const FUnHIDDeviceDescriptorReports> CachedDescriptorReports = FindDescriptorReports(DeviceInfo, ReportDescriptor))
+	{
+		return CachedDescriptorReports;
+	}
+
+	// parsed outside of the lock
+	FUnHIDDeviceDescriptorReports NewDescriptorReports = UUnHIDBlueprintFunctionLibrary::UnHIDGetReportsFromReportDescriptorBytes(ReportDescriptor, ErrorMessage);
+	if (!NewDescriptorReports.bValid)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<const FUnHIDDeviceDescriptorReports> DescriptorReports = MakeShared<const FUnHIDDeviceDescriptorReports>(MoveTemp(NewDescriptorReports));
+
+	FScopeLock Lock(&EntriesLock);
+
+	// a new device or a new descriptor for a known one
+	if (FUnHIDDescriptorCacheEntry* Entry = FindEntry(DeviceInfo))
+	{
+		*Entry = MakeEntry(DeviceInfo, ReportDescriptor, DescriptorReports);
+	}
+	else
+	{
+		Entries.Add(MakeEntry(DeviceInfo, ReportDescriptor, DescriptorReports));
+	}
+
+	ScheduleSave();
+
+	return DescriptorReports;
+}
+
+void FUnHIDDescriptorCache::Clear()
+{
+	uint64 Generation = 0;
+
+	{
+		FScopeLock Lock(&EntriesLock);
+
+		Entries.Empty();
+		Generation = ++SaveGeneration;
+		// the file could have been read before being deleted
+		bClearedWhileLoading = !bLoaded;
+		bSaveAfterLoad = false;
+	}
+
+	// pending saves will not resurrect the file
+	FScopeLock Lock(&SaveLock);
+
+	SavedGeneration = Generation;
+	IFileManager::Get().Delete(*Filename, false, false, true);
+}
+
+FUnHIDDescriptorCache::FUnHIDDescriptorCacheEntry FUnHIDDescriptorCache::MakeEntry(const FUnHIDDeviceInfo& DeviceInfo, const TArray<uint8>& ReportDescriptor, const TSharedPtr<const FUnHIDDeviceDescriptorReports>& DescriptorReports)
+{
+	FUnHIDDescriptorCacheEntry Entry;
+	Entry.VendorId = DeviceInfo.VendorId;
+	Entry.ProductId = DeviceInfo.ProductId;
+	Entry.ReleaseNumber = DeviceInfo.ReleaseNumber;
+	Entry.InterfaceNumber = DeviceInfo.InterfaceNumber;
+	Entry.UsagePage = DeviceInfo.UsagePage;
+	Entry.Usage = DeviceInfo.Usage;
+	Entry.ReportDescriptorHash = UnHID::GetReportDescriptorHash(ReportDescriptor);
+	Entry.ReportDescriptor = ReportDescriptor;
+	Entry.DescriptorReports = DescriptorReports;
+	return Entry;
+}
+
+void FUnHIDDescriptorCache::SaveEntriesToBytes(const TArray<FUnHIDDescriptorCacheEntry>& EntriesToSave, TArray<uint8>& Bytes)
+{
+	Bytes.Reset();
+	FMemoryWriter MemoryWriter(Bytes);
+
+	// saving does not modify the entries
+	SerializeEntries(MemoryWriter, const_cast<TArray<FUnHIDDescriptorCacheEntry>&>(EntriesToSave));
+
+	// the whole payload is checksummed, the parsed reports cannot be checked against the descriptor hash
+	uint64 Checksum = CityHash64(reinterpret_cast<const char*>(Bytes.GetData()), Bytes.Num());
+	MemoryWriter << Checksum;
+}
+
+bool FUnHIDDescriptorCache::LoadEntriesFromBytes(const TArray<uint8>& Bytes, TArray<FUnHIDDescriptorCacheEntry>& LoadedEntries)
+{
+	LoadedEntries.Empty();
+
+	const int32 PayloadSize = Bytes.Num() - static_cast<int32>(sizeof(uint64));
+	if (PayloadSize < 0)
+	{
+		return false;
+	}
+
+	uint64 Checksum = 0;
+	FMemoryReaderView ChecksumReader(TArrayView<const uint8>(Bytes.GetData() + PayloadSize, sizeof(uint64)));
+	ChecksumReader << Checksum;
+	if (Checksum != CityHash64(reinterpret_cast<const char*>(Bytes.GetData()), PayloadSize))
+	{
+		return false;
+	}
+
+	FMemoryReaderView MemoryReader(TArrayView<const uint8>(Bytes.GetData(), PayloadSize));
+	if (!SerializeEntries(MemoryReader, LoadedEntries))
+	{
+		LoadedEntries.Empty();
+		return false;
+	}
+
+	return true;
+}
+
+FUnHIDDescriptorCache::FUnHIDDescriptorCacheEntry* FUnHIDDescriptorCache::FindEntry(const FUnHIDDeviceInfo& DeviceInfo)
+{
+	for (FUnHIDDescriptorCacheEntry& Entry : Entries)
+	{
+		if (Entry.VendorId == DeviceInfo.VendorId &&
+			Entry.ProductId == DeviceInfo.ProductId &&
+			Entry.ReleaseNumber == DeviceInfo.ReleaseNumber &&
+			Entry.InterfaceNumber == DeviceInfo.InterfaceNumber &&
+			Entry.UsagePage == DeviceInfo.UsagePage &&
+			Entry.Usage == DeviceInfo.Usage)
+		{
+			return &Entry;
+		}
+	}
+
+	return nullptr;
+}
+
+void FUnHIDDescriptorCache::Load()
+{
+	TArray<uint8> Data;
+	TArray<FUnHIDDescriptorCacheEntry> LoadedEntries;
+	// a corrupted (or old) file is just ignored, it will be overwritten by the next Save()
+	if (FFileHelper::LoadFileToArray(Data, *Filename, FILEREAD_Silent))
+	{
+		LoadEntriesFromBytes(Data, LoadedEntries);
+	}
+
+	FScopeLock Lock(&EntriesLock);
+
+	bLoaded = true;
+	if (bClearedWhileLoading)
+	{
+		LoadedEntries.Empty();
+	}
+
+	// the entries parsed while loading are newer than the loaded ones
+	for (FUnHIDDescriptorCacheEntry& LoadedEntry : LoadedEntries)
+	{
+		const bool bParsedWhileLoading = Entries.ContainsByPredicate([&LoadedEntry](const FUnHIDDescriptorCacheEntry& Entry)
+			{
+				return Entry.VendorId == LoadedEntry.VendorId &&
+					Entry.ProductId == LoadedEntry.ProductId &&
+					Entry.ReleaseNumber == LoadedEntry.ReleaseNumber &&
+					Entry.InterfaceNumber == LoadedEntry.InterfaceNumber &&
+					Entry.UsagePage == LoadedEntry.UsagePage &&
+					Entry.Usage == LoadedEntry.Usage;
+			});
+		if (!bParsedWhileLoading)
+		{
+			Entries.Add(MoveTemp(LoadedEntry));
+		}
+	}
+
+	if (bSaveAfterLoad)
+	{
+		bSaveAfterLoad = false;
+		ScheduleSave();
+	}
+}
+
+void FUnHIDDescriptorCache::ScheduleSave()
+{
+	// a save before the load would overwrite the file with only the new entries
+	if (!bLoaded)
+	{
+		bSaveAfterLoad = true;
+		return;
+	}
+
+	// the snapshot shares the parsed reports, the file is written without the lock (and out of the game thread)
+	PendingSaves.RemoveAll([](const TFuture<void>& PendingSave) { return PendingSave.IsReady(); });
+	PendingSaves.Add(Async(EAsyncExecution::ThreadPool, [this, EntriesToSave = Entries, Generation = ++SaveGeneration]()
+		{
+			Save(EntriesToSave, Generation);
+		}));
+}
+
+void FUnHIDDescriptorCache::Save(const TArray<FUnHIDDescriptorCacheEntry>& EntriesToSave, const uint64 Generation)
+{
+	TArray<uint8> Data;
+	SaveEntriesToBytes(EntriesToSave, Data);
+
+	FScopeLock Lock(&SaveLock);
+
+	if (Generation <= SavedGeneration)
+	{
+		return;
+	}
+
+	SavedGeneration = Generation;
+	FFileHelper::SaveArrayToFile(Data, *Filename);
+}
+
+bool FUnHIDDescriptorCache::SerializeEntries(FArchive& Archive, TArray<FUnHIDDescriptorCacheEntry>& EntriesToSerialize)
+{
+	uint32 Magic = UnHID::DescriptorCacheMagic;
+	Archive << Magic;
+
+	int64 Version = UnHID::DescriptorCacheVersion;
+	UnHID::SerializeCompactInt(Archive, Version);
+
+	if (Archive.IsError() || Magic != UnHID::DescriptorCacheMagic || Version != UnHID::DescriptorCacheVersion)
+	{
+		return false;
+	}
+
+	int32 NumEntries = EntriesToSerialize.Num();
+	if (!UnHID::SerializeCompactNum(Archive, NumEntries))
+	{
+		return false;
+	}
+
+	EntriesToSerialize.SetNum(NumEntries);
+	for (FUnHIDDescriptorCacheEntry& Entry : EntriesToSerialize)
+	{
+		UnHID::SerializeCompactInt(Archive, Entry.VendorId);
+		UnHID::SerializeCompactInt(Archive, Entry.ProductId);
+		UnHID::SerializeCompactInt(Archive, Entry.ReleaseNumber);
+		UnHID::SerializeCompactInt(Archive, Entry.InterfaceNumber);
+		UnHID::SerializeCompactInt(Archive, Entry.UsagePage);
+		UnHID::SerializeCompactInt(Archive, Entry.Usage);
+		Archive << Entry.ReportDescriptorHash;
+
+		int32 ReportDescriptorSize = Entry.ReportDescriptor.Num();
+		if (!UnHID::SerializeCompactNum(Archive, ReportDescriptorSize))
+		{
+			return false;
+		}
+		Entry.ReportDescriptor.SetNumUninitialized(ReportDescriptorSize);
+		Archive.Serialize(Entry.ReportDescriptor.GetData(), ReportDescriptorSize);
+
+		FUnHIDDeviceDescriptorReports DescriptorReports;
+		if (!Archive.IsLoading() && Entry.DescriptorReports)
+		{
+			DescriptorReports = *Entry.DescriptorReports;
+		}
+
+		UnHID::SerializeDescriptorReports(Archive, DescriptorReports.Inputs);
+		UnHID::SerializeDescriptorReports(Archive, DescriptorReports.Outputs);
+		UnHID::SerializeDescriptorReports(Archive, DescriptorReports.Features);
+
+		if (Archive.IsError())
+		{
+			return false;
+		}
+
+		if (Archive.IsLoading())
+		{
+			// the hash protects from truncated or altered descriptors
+			if (Entry.ReportDescriptorHash != UnHID::GetReportDescriptorHash(Entry.ReportDescriptor))
+			{
+				return false;
+			}
+
+			if (!UnHID::IsValidDescriptorReports(DescriptorReports.Inputs) || !UnHID::IsValidDescriptorReports(DescriptorReports.Outputs) || !UnHID::IsValidDescriptorReports(DescriptorReports.Features))
+			{
+				return false;
+			}
+			DescriptorReports.bValid = true;
+			Entry.DescriptorReports = MakeShared<const FUnHIDDeviceDescriptorReports>(MoveTemp(DescriptorReports));
+		}
+	}
+
+	return !Archive.IsError();
+}
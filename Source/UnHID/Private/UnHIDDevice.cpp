@@ -8,6 +8,17 @@ THIRD_PARTY_INCLUDES_START
 THIRD_PARTY_INCLUDES_END
 
 #include "UnHIDBlueprintFunctionLibrary.h"
+#include "UnHIDBulkTransfer.h"
+#include "UnHIDDescriptorCache.h"
+#include "UnHIDDeviceReader.h"
+#include "UnHIDDeviceWriter.h"
+#include "UnHIDFeaturePollScheduler.h"
+#include "UnHIDReportDecoder.h"
+#include "UnHIDResponseMatcher.h"
+#include "UnHIDUsageIndex.h"
+#if PLATFORM_LINUX
+#include "Linux/UnHIDLinuxReaderService.h"
+#endif
 
 EUnHIDBusType UnHID::ToUnHIDBusType(const int32 BusType)
 {
@@ -45,14 +56,31 @@ void UnHID::FillDeviceInfo(const hid_device_info* CurrentDev, FUnHIDDeviceInfo&
 	UnHIDDeviceInfo.BusType = UnHID::ToUnHIDBusType(CurrentDev->bus_type);
 }
 
+bool UnHID::MatchBytesWithMask(TArrayView<const uint8> Bytes, TArrayView<const uint8> Pattern, TArrayView<const uint8> Mask)
+{
+	if (Bytes.Num() < Pattern.Num())
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < Pattern.Num(); Index++)
+	{
+		const uint8 MaskByte = Index < Mask.Num() ? Mask[Index] : 0xFF;
+		if ((Bytes[Index] & MaskByte) != (Pattern[Index] & MaskByte))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 class FUnHIDDeviceWorkerThread : public FRunnable
 {
 public:
-	FUnHIDDeviceWorkerThread(TWeakObjectPtr<UUnHIDDevice> InUnHIDDevice, hid_device* InHidDevice, const FUnHIDReadNativeDelegate& InReadNativeDelegate) : bStopThread(false)
+	FUnHIDDeviceWorkerThread(FUnHIDDeviceReader* InUnHIDDeviceReader) : bStopThread(false)
 	{
-		UnHIDDevice = InUnHIDDevice;
-		HidDevice = InHidDevice;
-		ReadNativeDelegate = InReadNativeDelegate;
+		UnHIDDeviceReader = InUnHIDDeviceReader;
 		Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("UnHIDDeviceWorkerThread@%p"), this));
 	}
 
@@ -76,168 +104,894 @@ public:
 
 	virtual uint32 Run() override
 	{
-		ReadBuffer.AddZeroed(0xFFFF);
-
+		// block until a report arrives, Stop() wakes up the read
 		while (!bStopThread)
 		{
-			const int32 ReadSize = hid_read_timeout(HidDevice, ReadBuffer.GetData(), ReadBuffer.NumBytes(), 100);
-			if (ReadSize < 0)
+			if (UnHIDDeviceReader->ReadReport(-1) < 0)
 			{
-				const FString ErrorMessage = WCHAR_TO_TCHAR(hid_read_error(HidDevice));
-				FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([this, ErrorMessage]()
-					{
-						if (UnHIDDevice.IsValid())
-						{
-							ReadNativeDelegate.Execute(UnHIDDevice.Get(), {}, ErrorMessage);
-						}
-					}, TStatId(), nullptr, ENamedThreads::GameThread);
 				break;
 			}
-			else if (ReadSize == 0)
+		}
+
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopThread = true;
+		UnHIDDeviceReader->Interrupt();
+	}
+
+	virtual void Exit() override
+	{
+
+	}
+
+private:
+	FRunnableThread* Thread;
+
+	TAtomic<bool> bStopThread;
+
+	FUnHIDDeviceReader* UnHIDDeviceReader;
+};
+
+bool UUnHIDDevice::Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadNativeDelegate& InReadNativeDelegate, FString& ErrorMessage)
+{
+	return Initialize(UnHIDDeviceInfo, FUnHIDDeviceReadOptions(), InReadNativeDelegate, ErrorMessage);
+}
+
+bool UUnHIDDevice::Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadBatchNativeDelegate& InReadBatchNativeDelegate, FString& ErrorMessage)
+{
+	return Initialize(UnHIDDeviceInfo, FUnHIDDeviceReadOptions(), InReadBatchNativeDelegate, ErrorMessage);
+}
+
+bool UUnHIDDevice::Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& InReadOptions, const FUnHIDReadNativeDelegate& InReadNativeDelegate, FString& ErrorMessage)
+{
+	FUnHIDReadWithTimestampNativeDelegate ReadWithTimestampNativeDelegate;
+	if (InReadNativeDelegate.IsBound())
+	{
+		ReadWithTimestampNativeDelegate.BindLambda([InReadNativeDelegate](UUnHIDDevice* UnHIDDevice, const TArray<uint8>& Data, const int64 Timestamp, const FString& ErrorMessage)
+			{
+				InReadNativeDelegate.ExecuteIfBound(UnHIDDevice, Data, ErrorMessage);
+			});
+	}
+
+	return Initialize(UnHIDDeviceInfo, InReadOptions, ReadWithTimestampNativeDelegate, ErrorMessage);
+}
+
+bool UUnHIDDevice::Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadWithTimestampNativeDelegate& InReadWithTimestampNativeDelegate, FString& ErrorMessage)
+{
+	return Initialize(UnHIDDeviceInfo, FUnHIDDeviceReadOptions(), InReadWithTimestampNativeDelegate, ErrorMessage);
+}
+
+bool UUnHIDDevice::Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& InReadOptions, const FUnHIDReadWithTimestampNativeDelegate& InReadWithTimestampNativeDelegate, FString& ErrorMessage)
+{
+	if (!InReadWithTimestampNativeDelegate.IsBound())
+	{
+		ErrorMessage = "Unbound delegate";
+		return false;
+	}
+
+	if (!OpenHidDevice(UnHIDDeviceInfo, ErrorMessage))
+	{
+		return false;
+	}
+
+	ReadNativeDelegate = InReadWithTimestampNativeDelegate;
+	ReadBatchNativeDelegate.Unbind();
+	ReadAnyThreadNativeDelegate.Unbind();
+
+	StartWorkerThread(InReadOptions);
+
+	return true;
+}
+
+bool UUnHIDDevice::Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& InReadOptions, const FUnHIDReadBatchNativeDelegate& InReadBatchNativeDelegate, FString& ErrorMessage)
+{
+	if (!InReadBatchNativeDelegate.IsBound())
+	{
+		ErrorMessage = "Unbound delegate";
+		return false;
+	}
+
+	if (!OpenHidDevice(UnHIDDeviceInfo, ErrorMessage))
+	{
+		return false;
+	}
+
+	ReadNativeDelegate.Unbind();
+	ReadBatchNativeDelegate = InReadBatchNativeDelegate;
+	ReadAnyThreadNativeDelegate.Unbind();
+
+	StartWorkerThread(InReadOptions);
+
+	return true;
+}
+
+bool UUnHIDDevice::Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadAnyThreadNativeDelegate& InReadAnyThreadNativeDelegate, FString& ErrorMessage)
+{
+	return Initialize(UnHIDDeviceInfo, FUnHIDDeviceReadOptions(), InReadAnyThreadNativeDelegate, ErrorMessage);
+}
+
+bool UUnHIDDevice::Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& InReadOptions, const FUnHIDReadAnyThreadNativeDelegate& InReadAnyThreadNativeDelegate, FString& ErrorMessage)
+{
+	if (!InReadAnyThreadNativeDelegate.IsBound())
+	{
+		ErrorMessage = "Unbound delegate";
+		return false;
+	}
+
+	if (!OpenHidDevice(UnHIDDeviceInfo, ErrorMessage))
+	{
+		return false;
+	}
+
+	ReadNativeDelegate.Unbind();
+	ReadBatchNativeDelegate.Unbind();
+	ReadAnyThreadNativeDelegate = InReadAnyThreadNativeDelegate;
+
+	// nothing is queued for the game thread
+	FUnHIDDeviceReadOptions AnyThreadReadOptions = InReadOptions;
+	AnyThreadReadOptions.QueuePolicy = EUnHIDReadQueuePolicy::DropNewest;
+	AnyThreadReadOptions.MaxQueuedReports = 1;
+	StartWorkerThread(AnyThreadReadOptions);
+
+	return true;
+}
+
+bool UUnHIDDevice::OpenHidDevice(const FUnHIDDeviceInfo& UnHIDDeviceInfo, FString& ErrorMessage)
+{
+	if (HidDevice || UnHIDDeviceReader)
+	{
+		ErrorMessage = "Already initialized";
+		return false;
+	}
+
+	if (UnHIDDeviceInfo.Path.IsEmpty())
+	{
+		ErrorMessage = "Empty UnHIDDeviceInfo Path";
+		return false;
+	}
+
+	HidDevice = hid_open_path(TCHAR_TO_UTF8(*UnHIDDeviceInfo.Path));
+	if (!HidDevice)
+	{
+		ErrorMessage = WCHAR_TO_TCHAR(hid_error(nullptr));
+		return false;
+	}
+
+	ReportDescriptor = MakeShared<TArray<uint8>>();
+	ReportDescriptor->AddUninitialized(HID_API_MAX_REPORT_DESCRIPTOR_SIZE);
+
+	const int32 ReportDescriptorSize = hid_get_report_descriptor(reinterpret_cast<hid_device*>(HidDevice), ReportDescriptor->GetData(), ReportDescriptor->Num());
+
+	if (ReportDescriptorSize > 0)
+	{
+		ReportDescriptor->SetNum(ReportDescriptorSize);
+	}
+	else
+	{
+		ReportDescriptor = nullptr;
+	}
+
+	hid_device_info* HidDeviceInfo = hid_get_device_info(reinterpret_cast<hid_device*>(HidDevice));
+	if (HidDeviceInfo)
+	{
+		DeviceInfo = MakeShared<FUnHIDDeviceInfo>();
+		UnHID::FillDeviceInfo(HidDeviceInfo, *DeviceInfo);
+	}
+
+	return true;
+}
+
+void UUnHIDDevice::StartWorkerThread(const FUnHIDDeviceReadOptions& InReadOptions)
+{
+	bReadErrorDispatched = false;
+	LastDroppedReports = 0;
+
+	// if the descriptor is not available, fallback to report ids (at most 256 coalesced reports) and to the default report size
+	bool bHasReportIds = true;
+	int32 ReportSize = 0;
+	FString IgnoredErrorMessage;
+	if (ParseDescriptorReports(IgnoredErrorMessage) && DescriptorReports->Inputs.Num() > 0)
+	{
+		bHasReportIds = DescriptorReports->Inputs.Num() > 1 || DescriptorReports->Inputs[0].ReportId != 0;
+		for (const FUnHIDDeviceDescriptorReport& Input : DescriptorReports->Inputs)
+		{
+			ReportSize = FMath::Max(ReportSize, Input.NumBytes);
+		}
+
+		// the report id is prefixed to the report data
+		if (bHasReportIds)
+		{
+			ReportSize++;
+		}
+	}
+
+	UnHIDResponseMatcher = new FUnHIDResponseMatcher(this);
+
+	UnHIDDeviceReader = new FUnHIDDeviceReader(reinterpret_cast<hid_device*>(HidDevice), InReadOptions, bHasReportIds, ReportSize);
+	UnHIDDeviceReader->SetResponseMatcher(UnHIDResponseMatcher);
+	if (ReadAnyThreadNativeDelegate.IsBound())
+	{
+		UnHIDDeviceReader->SetAnyThreadDelegate(this, ReadAnyThreadNativeDelegate);
+	}
+
+#if PLATFORM_LINUX
+	// a single epoll thread serves all of the devices, fallback to a dedicated thread if it is not available
+	if (FUnHIDLinuxReaderService::Get().Register(UnHIDDeviceReader))
+	{
+		return;
+	}
+#endif
+
+	UnHIDDeviceWorkerThread = new FUnHIDDeviceWorkerThread(UnHIDDeviceReader);
+}
+
+UUnHIDDevice::~UUnHIDDevice()
+{
+	Terminate();
+}
+
+void UUnHIDDevice::Tick(float DeltaTime)
+{
+	if (!UnHIDDeviceReader)
+	{
+		return;
+	}
+
+	// the batch storage is reused, so after the first frames there are no more allocations
+	ReadReportBatch.Reset();
+	UnHIDDeviceReader->CollectReports(ReadReportBatch);
+
+	const uint64 DroppedReports = UnHIDDeviceReader->GetDroppedReports();
+	ReadReportBatch.DroppedCount = static_cast<int32>(FMath::Min<uint64>(DroppedReports - LastDroppedReports, MAX_int32));
+	LastDroppedReports = DroppedReports;
+
+	if (ReadBatchNativeDelegate.IsBound())
+	{
+		if (ReadReportBatch.Num() > 0 || ReadReportBatch.DroppedCount > 0)
+		{
+			ReadBatchNativeDelegate.Execute(this, ReadReportBatch, "");
+		}
+	}
+	else
+	{
+		for (int32 ReportIndex = 0; ReportIndex < ReadReportBatch.Num(); ReportIndex++)
+		{
+			// reuse the same allocation for every report
+			const TArrayView<const uint8> Report = ReadReportBatch.GetReport(ReportIndex);
+			ReadReport.Reset();
+			ReadReport.Append(Report.GetData(), Report.Num());
+
+			ReadNativeDelegate.ExecuteIfBound(this, ReadReport, ReadReportBatch.Timestamps[ReportIndex], "");
+
+			// the delegate could have terminated the device
+			if (!UnHIDDeviceReader)
 			{
-				// timeout
-				continue;
+				return;
 			}
+		}
+	}
 
-			TArray<uint8> HidMessage;
-			HidMessage.Append(ReadBuffer.GetData(), ReadSize);
+	// the delegate could have terminated the device
+	if (!UnHIDDeviceReader)
+	{
+		return;
+	}
 
-			FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([this, HidMessage]()
-				{
-					if (UnHIDDevice.IsValid())
-					{
-						ReadNativeDelegate.Execute(UnHIDDevice.Get(), HidMessage, "");
-					}
-				}, TStatId(), nullptr, ENamedThreads::GameThread);
+	if (UsagesChangedNativeDelegate.IsBound() || UsageChangedNativeDelegate.IsBound())
+	{
+		for (int32 ReportIndex = 0; ReportIndex < ReadReportBatch.Num(); ReportIndex++)
+		{
+			if (!DetectChanges(ReadReportBatch.GetReport(ReportIndex)))
+			{
+				return;
+			}
 		}
+	}
 
-		return 0;
+	FString ErrorMessage;
+	if (!bReadErrorDispatched && !UnHIDDeviceReader->HasPendingReports() && UnHIDDeviceReader->GetReadError(ErrorMessage))
+	{
+		bReadErrorDispatched = true;
+		if (ReadBatchNativeDelegate.IsBound())
+		{
+			ReadReportBatch.Reset();
+			ReadBatchNativeDelegate.Execute(this, ReadReportBatch, ErrorMessage);
+		}
+		else
+		{
+			ReadNativeDelegate.ExecuteIfBound(this, {}, static_cast<int64>(FPlatformTime::Cycles64()), ErrorMessage);
+		}
+	}
+}
+
+ETickableTickType UUnHIDDevice::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UUnHIDDevice::IsTickable() const
+{
+	// reports are delivered on the reader thread when the any-thread delegate is used
+	return UnHIDDeviceReader != nullptr && !ReadAnyThreadNativeDelegate.IsBound();
+}
+
+TStatId UUnHIDDevice::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UUnHIDDevice, STATGROUP_Tickables);
+}
+
+void UUnHIDDevice::StopWorkerThread()
+{
+	if (UnHIDDeviceWorkerThread)
+	{
+		UnHIDDeviceWorkerThread->Stop();
+	}
+
+#if PLATFORM_LINUX
+	if (UnHIDDeviceReader)
+	{
+		if (FUnHIDLinuxReaderService* LinuxReaderService = FUnHIDLinuxReaderService::GetPtr())
+		{
+			LinuxReaderService->Unregister(UnHIDDeviceReader);
+		}
+	}
+#endif
+}
+
+void UUnHIDDevice::Terminate()
+{
+	StopWorkerThread();
+
+	if (UnHIDDeviceWorkerThread)
+	{
+		delete UnHIDDeviceWorkerThread;
+	}
+
+	UnHIDDeviceWorkerThread = nullptr;
+
+	// waits for the frame (or the acknowledgement) in progress
+	if (UnHIDBulkTransfer)
+	{
+		delete UnHIDBulkTransfer;
+	}
+
+	UnHIDBulkTransfer = nullptr;
+
+	// waits for the poll in progress (if any)
+	if (FUnHIDFeaturePollScheduler* FeaturePollScheduler = FUnHIDFeaturePollScheduler::GetPtr())
+	{
+		FeaturePollScheduler->UnregisterDevice(this);
+	}
+
+	// pending writes are completed with an error
+	if (UnHIDDeviceWriter)
+	{
+		delete UnHIDDeviceWriter;
+	}
+
+	UnHIDDeviceWriter = nullptr;
+
+	if (UnHIDDeviceReader)
+	{
+		delete UnHIDDeviceReader;
+	}
+
+	UnHIDDeviceReader = nullptr;
+
+	// pending requests are completed with an error
+	if (UnHIDResponseMatcher)
+	{
+		delete UnHIDResponseMatcher;
+	}
+
+	UnHIDResponseMatcher = nullptr;
+
+	if (HidDevice)
+	{
+		hid_close(reinterpret_cast<hid_device*>(HidDevice));
+	}
+
+	HidDevice = nullptr;
+}
+
+bool UUnHIDDevice::WriteBytes(const TArray<uint8>& Bytes, FString& ErrorMessage)
+{
+	if (!HidDevice)
+	{
+		ErrorMessage = "Invalid HidDevice";
+		return false;
+	}
+
+	FScopeLock Lock(&HidDeviceLock);
+
+	const int32 WriteSize = hid_write(reinterpret_cast<hid_device*>(HidDevice), Bytes.GetData(), Bytes.Num());
+	if (WriteSize <= 0)
+	{
+		ErrorMessage = WCHAR_TO_TCHAR(hid_error(reinterpret_cast<hid_device*>(HidDevice)));
+		return false;
+	}
+
+	return true;
+}
+
+FUnHIDDeviceWriter* UUnHIDDevice::GetOrCreateWriter()
+{
+	// asynchronous writes could be requested by the any-thread read delegate too
+	FScopeLock Lock(&HidDeviceLock);
+
+	if (!HidDevice)
+	{
+		return nullptr;
+	}
+
+	if (!UnHIDDeviceWriter)
+	{
+		// DescriptorReports has already been parsed when starting the reader
+		int32 ReportSize = 0;
+		if (DescriptorReports.IsValid())
+		{
+			for (const FUnHIDDeviceDescriptorReport& Report : DescriptorReports->Outputs)
+			{
+				ReportSize = FMath::Max(ReportSize, Report.NumBytes);
+			}
+			for (const FUnHIDDeviceDescriptorReport& Report : DescriptorReports->Features)
+			{
+				ReportSize = FMath::Max(ReportSize, Report.NumBytes);
+			}
+
+			// the report id byte is always sent (0 when not used)
+			if (ReportSize > 0)
+			{
+				ReportSize++;
+			}
+		}
+
+		UnHIDDeviceWriter = new FUnHIDDeviceWriter(this, ReportSize, UnHIDResponseMatcher);
+		UnHIDDeviceWriter->SetWriteOptions(WriteOptions);
+	}
+
+	return UnHIDDeviceWriter;
+}
+
+bool UUnHIDDevice::WriteBytesAsync(const TArray<uint8>& Bytes, const FUnHIDWriteDynamicDelegate& OnWriteCompleted, FString& ErrorMessage)
+{
+	FUnHIDWriteNativeDelegate OnWriteCompletedNative;
+	OnWriteCompletedNative.BindLambda([OnWriteCompleted](UUnHIDDevice* UnHIDDevice, const FUnHIDWriteResult& WriteResult)
+		{
+			OnWriteCompleted.ExecuteIfBound(UnHIDDevice, WriteResult);
+		});
+
+	return WriteBytesAsync(Bytes, OnWriteCompletedNative, ErrorMessage);
+}
+
+bool UUnHIDDevice::WriteBytesAsync(const TArray<uint8>& Bytes, const FUnHIDWriteNativeDelegate& OnWriteCompleted, FString& ErrorMessage)
+{
+	FUnHIDDeviceWriter* Writer = GetOrCreateWriter();
+	if (!Writer)
+	{
+		ErrorMessage = "Invalid HidDevice";
+		return false;
+	}
+
+	return Writer->Enqueue(EUnHIDWriteType::Output, Bytes, OnWriteCompleted, ErrorMessage);
+}
+
+TFuture<FUnHIDWriteResult> UUnHIDDevice::WriteBytesAsync(const TArray<uint8>& Bytes)
+{
+	FUnHIDDeviceWriter* Writer = GetOrCreateWriter();
+	if (!Writer)
+	{
+		FUnHIDWriteResult WriteResult;
+		WriteResult.ErrorMessage = "Invalid HidDevice";
+		TPromise<FUnHIDWriteResult> Promise;
+		Promise.SetValue(WriteResult);
+		return Promise.GetFuture();
+	}
+
+	return Writer->Enqueue(EUnHIDWriteType::Output, Bytes);
+}
+
+bool UUnHIDDevice::SetFeatureReportBytesAsync(const TArray<uint8>& Bytes, const FUnHIDWriteDynamicDelegate& OnWriteCompleted, FString& ErrorMessage)
+{
+	FUnHIDWriteNativeDelegate OnWriteCompletedNative;
+	OnWriteCompletedNative.BindLambda([OnWriteCompleted](UUnHIDDevice* UnHIDDevice, const FUnHIDWriteResult& WriteResult)
+		{
+			OnWriteCompleted.ExecuteIfBound(UnHIDDevice, WriteResult);
+		});
+
+	return SetFeatureReportBytesAsync(Bytes, OnWriteCompletedNative, ErrorMessage);
+}
+
+bool UUnHIDDevice::SetFeatureReportBytesAsync(const TArray<uint8>& Bytes, const FUnHIDWriteNativeDelegate& OnWriteCompleted, FString& ErrorMessage)
+{
+	FUnHIDDeviceWriter* Writer = GetOrCreateWriter();
+	if (!Writer)
+	{
+		ErrorMessage = "Invalid HidDevice";
+		return false;
+	}
+
+	return Writer->Enqueue(EUnHIDWriteType::Feature, Bytes, OnWriteCompleted, ErrorMessage);
+}
+
+TFuture<FUnHIDWriteResult> UUnHIDDevice::SetFeatureReportBytesAsync(const TArray<uint8>& Bytes)
+{
+	FUnHIDDeviceWriter* Writer = GetOrCreateWriter();
+	if (!Writer)
+	{
+		FUnHIDWriteResult WriteResult;
+		WriteResult.ErrorMessage = "Invalid HidDevice";
+		TPromise<FUnHIDWriteResult> Promise;
+		Promise.SetValue(WriteResult);
+		return Promise.GetFuture();
+	}
+
+	return Writer->Enqueue(EUnHIDWriteType::Feature, Bytes);
+}
+
+bool UUnHIDDevice::WriteBytesCoalesced(const TArray<uint8>& Bytes, FString& ErrorMessage)
+{
+	if (Bytes.Num() < 1)
+	{
+		ErrorMessage = "Empty report";
+		return false;
+	}
+
+	FUnHIDDeviceWriter* Writer = GetOrCreateWriter();
+	if (!Writer)
+	{
+		ErrorMessage = "Invalid HidDevice";
+		return false;
+	}
+
+	return Writer->EnqueueCoalesced(Bytes, ErrorMessage);
+}
+
+void UUnHIDDevice::SetWriteOptions(const FUnHIDDeviceWriteOptions& InWriteOptions)
+{
+	FScopeLock Lock(&HidDeviceLock);
+
+	WriteOptions = InWriteOptions;
+	if (UnHIDDeviceWriter)
+	{
+		UnHIDDeviceWriter->SetWriteOptions(WriteOptions);
+	}
+}
+
+bool UUnHIDDevice::GetFeatureReportBytesAsync(const uint8 ReportId, const int32 Size, const FUnHIDReadResultDynamicDelegate& OnReportReceived, FString& ErrorMessage)
+{
+	FUnHIDReadResultNativeDelegate OnReportReceivedNative;
+	OnReportReceivedNative.BindLambda([OnReportReceived](UUnHIDDevice* UnHIDDevice, const FUnHIDReadResult& ReadResult)
+		{
+			OnReportReceived.ExecuteIfBound(UnHIDDevice, ReadResult);
+		});
+
+	return GetFeatureReportBytesAsync(ReportId, Size, OnReportReceivedNative, ErrorMessage);
+}
+
+bool UUnHIDDevice::GetFeatureReportBytesAsync(const uint8 ReportId, const int32 Size, const FUnHIDReadResultNativeDelegate& OnReportReceived, FString& ErrorMessage)
+{
+	if (Size < 0)
+	{
+		ErrorMessage = "Negative Size";
+		return false;
+	}
+
+	FUnHIDDeviceWriter* Writer = GetOrCreateWriter();
+	if (!Writer)
+	{
+		ErrorMessage = "Invalid HidDevice";
+		return false;
+	}
+
+	return Writer->EnqueueGetFeature(ReportId, Size, OnReportReceived, ErrorMessage);
+}
+
+TFuture<FUnHIDReadResult> UUnHIDDevice::GetFeatureReportBytesAsync(const uint8 ReportId, const int32 Size)
+{
+	FUnHIDDeviceWriter* Writer = Size >= 0 ? GetOrCreateWriter() : nullptr;
+	if (!Writer)
+	{
+		FUnHIDReadResult ReadResult;
+		ReadResult.ErrorMessage = Size < 0 ? "Negative Size" : "Invalid HidDevice";
+		TPromise<FUnHIDReadResult> Promise;
+		Promise.SetValue(ReadResult);
+		return Promise.GetFuture();
+	}
+
+	return Writer->EnqueueGetFeature(ReportId, Size);
+}
+
+bool UUnHIDDevice::GetFeatureReportsSizes(const TArray<uint8>& ReportIds, TArray<int32>& Sizes, FString& ErrorMessage) const
+{
+	if (!DescriptorReports.IsValid())
+	{
+		ErrorMessage = "Invalid Report Descriptor";
+		return false;
+	}
+
+	if (ReportIds.Num() < 1)
+	{
+		ErrorMessage = "Empty ReportIds";
+		return false;
+	}
+
+	Sizes.Reset(ReportIds.Num());
+	for (const uint8 ReportId : ReportIds)
+	{
+		const FUnHIDDeviceDescriptorReport* FeatureReport = DescriptorReports->Features.FindByPredicate([ReportId](const FUnHIDDeviceDescriptorReport& Report) { return Report.ReportId == ReportId; });
+		if (!FeatureReport)
+		{
+			ErrorMessage = FString::Printf(TEXT("Unknown Feature Report %u"), ReportId);
+			return false;
+		}
+		Sizes.Add(FeatureReport->NumBytes);
+	}
+
+	return true;
+}
+
+bool UUnHIDDevice::GetFeatureReportsBytesAsync(const TArray<uint8>& ReportIds, const FUnHIDFeatureReportsDynamicDelegate& OnReportsReceived, FString& ErrorMessage)
+{
+	FUnHIDFeatureReportsNativeDelegate OnReportsReceivedNative;
+	OnReportsReceivedNative.BindLambda([OnReportsReceived](UUnHIDDevice* UnHIDDevice, const FUnHIDFeatureReportsResult& FeatureReportsResult)
+		{
+			OnReportsReceived.ExecuteIfBound(UnHIDDevice, FeatureReportsResult);
+		});
+
+	return GetFeatureReportsBytesAsync(ReportIds, OnReportsReceivedNative, ErrorMessage);
+}
+
+bool UUnHIDDevice::GetFeatureReportsBytesAsync(const TArray<uint8>& ReportIds, const FUnHIDFeatureReportsNativeDelegate& OnReportsReceived, FString& ErrorMessage)
+{
+	TArray<int32> Sizes;
+	if (!GetFeatureReportsSizes(ReportIds, Sizes, ErrorMessage))
+	{
+		return false;
+	}
+
+	FUnHIDDeviceWriter* Writer = GetOrCreateWriter();
+	if (!Writer)
+	{
+		ErrorMessage = "Invalid HidDevice";
+		return false;
+	}
+
+	return Writer->EnqueueFeatureReports(ReportIds, Sizes, OnReportsReceived, ErrorMessage);
+}
+
+TFuture<FUnHIDFeatureReportsResult> UUnHIDDevice::GetFeatureReportsBytesAsync(const TArray<uint8>& ReportIds)
+{
+	TArray<int32> Sizes;
+	FString ErrorMessage;
+	FUnHIDDeviceWriter* Writer = GetFeatureReportsSizes(ReportIds, Sizes, ErrorMessage) ? GetOrCreateWriter() : nullptr;
+	if (!Writer)
+	{
+		FUnHIDFeatureReportsResult FeatureReportsResult;
+		FeatureReportsResult.Reports.SetNum(ReportIds.Num());
+		for (FUnHIDReadResult& ReportResult : FeatureReportsResult.Reports)
+		{
+			ReportResult.ErrorMessage = ErrorMessage.IsEmpty() ? "Invalid HidDevice" : ErrorMessage;
+		}
+		TPromise<FUnHIDFeatureReportsResult> Promise;
+		Promise.SetValue(FeatureReportsResult);
+		return Promise.GetFuture();
+	}
+
+	return Writer->EnqueueFeatureReports(ReportIds, Sizes);
+}
+
+bool UUnHIDDevice::SendRequestBytes(const TArray<uint8>& Bytes, const TArray<uint8>& ResponsePattern, const TArray<uint8>& ResponseMask, const float TimeoutSeconds, const FUnHIDReadResultDynamicDelegate& OnResponseReceived, FString& ErrorMessage)
+{
+	FUnHIDResponsePredicate ResponsePredicate;
+	ResponsePredicate.BindLambda([ResponsePattern, ResponseMask](TArrayView<const uint8> Report)
+		{
+			return UnHID::MatchBytesWithMask(Report, ResponsePattern, ResponseMask);
+		});
+
+	FUnHIDReadResultNativeDelegate OnResponseReceivedNative;
+	OnResponseReceivedNative.BindLambda([OnResponseReceived](UUnHIDDevice* UnHIDDevice, const FUnHIDReadResult& ReadResult)
+		{
+			OnResponseReceived.ExecuteIfBound(UnHIDDevice, ReadResult);
+		});
+
+	return SendRequestBytes(Bytes, ResponsePredicate, TimeoutSeconds, OnResponseReceivedNative, ErrorMessage);
+}
+
+bool UUnHIDDevice::SendRequestBytes(const TArray<uint8>& Bytes, const FUnHIDResponsePredicate& ResponsePredicate, const float TimeoutSeconds, const FUnHIDReadResultNativeDelegate& OnResponseReceived, FString& ErrorMessage)
+{
+	if (Bytes.Num() < 1)
+	{
+		ErrorMessage = "Empty Bytes";
+		return false;
 	}
 
-	virtual void Stop() override
+	if (!ResponsePredicate.IsBound())
 	{
-		bStopThread = true;
+		ErrorMessage = "Unbound delegate";
+		return false;
 	}
 
-	virtual void Exit() override
+	FUnHIDDeviceWriter* Writer = GetOrCreateWriter();
+	if (!Writer)
 	{
+		ErrorMessage = "Invalid HidDevice";
+		return false;
+	}
+
+	return Writer->EnqueueRequest(Bytes, ResponsePredicate, TimeoutSeconds, OnResponseReceived, ErrorMessage);
+}
 
+TFuture<FUnHIDReadResult> UUnHIDDevice::SendRequestBytes(const TArray<uint8>& Bytes, const FUnHIDResponsePredicate& ResponsePredicate, const float TimeoutSeconds)
+{
+	FUnHIDDeviceWriter* Writer = Bytes.Num() > 0 && ResponsePredicate.IsBound() ? GetOrCreateWriter() : nullptr;
+	if (!Writer)
+	{
+		FUnHIDReadResult ReadResult;
+		ReadResult.ErrorMessage = Bytes.Num() < 1 ? "Empty Bytes" : (!ResponsePredicate.IsBound() ? "Unbound delegate" : "Invalid HidDevice");
+		TPromise<FUnHIDReadResult> Promise;
+		Promise.SetValue(ReadResult);
+		return Promise.GetFuture();
 	}
 
-private:
-	FRunnableThread* Thread;
+	return Writer->EnqueueRequest(Bytes, ResponsePredicate, TimeoutSeconds);
+}
 
-	TAtomic<bool> bStopThread;
+TFuture<FUnHIDReadResult> UUnHIDDevice::SendRequestBytes(const TArray<uint8>& Bytes, const TArray<uint8>& ResponsePattern, const TArray<uint8>& ResponseMask, const float TimeoutSeconds)
+{
+	FUnHIDResponsePredicate ResponsePredicate;
+	ResponsePredicate.BindLambda([ResponsePattern, ResponseMask](TArrayView<const uint8> Report)
+		{
+			return UnHID::MatchBytesWithMask(Report, ResponsePattern, ResponseMask);
+		});
 
-	hid_device* HidDevice;
+	return SendRequestBytes(Bytes, ResponsePredicate, TimeoutSeconds);
+}
 
-	TWeakObjectPtr<UUnHIDDevice> UnHIDDevice;
-	FUnHIDReadNativeDelegate ReadNativeDelegate;
+bool UUnHIDDevice::StartBulkTransfer(const TArray<uint8>& Data, const FUnHIDBulkTransferOptions& BulkTransferOptions, const FUnHIDBulkTransferDynamicDelegate& OnBulkTransferCompleted, FString& ErrorMessage)
+{
+	FUnHIDBulkTransferNativeDelegate OnBulkTransferCompletedNative;
+	OnBulkTransferCompletedNative.BindLambda([OnBulkTransferCompleted](UUnHIDDevice* UnHIDDevice, const FUnHIDBulkTransferStats& BulkTransferStats)
+		{
+			OnBulkTransferCompleted.ExecuteIfBound(UnHIDDevice, BulkTransferStats);
+		});
 
-	TArray<uint8> ReadBuffer;
-};
+	return StartBulkTransfer(Data, BulkTransferOptions, OnBulkTransferCompletedNative, ErrorMessage);
+}
 
-bool UUnHIDDevice::Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadNativeDelegate& InReadNativeDelegate, FString& ErrorMessage)
+bool UUnHIDDevice::StartBulkTransfer(const TArray<uint8>& Data, const FUnHIDBulkTransferOptions& BulkTransferOptions, const FUnHIDBulkTransferNativeDelegate& OnBulkTransferCompleted, FString& ErrorMessage)
 {
-	if (HidDevice || UnHIDDeviceWorkerThread)
+	if (!HidDevice)
 	{
-		ErrorMessage = "Already initialized";
+		ErrorMessage = "Invalid HidDevice";
 		return false;
 	}
 
-	if (!InReadNativeDelegate.IsBound())
+	if (Data.Num() < 1)
 	{
-		ErrorMessage = "Unbound delegate";
+		ErrorMessage = "Empty Data";
 		return false;
 	}
 
-	if (UnHIDDeviceInfo.Path.IsEmpty())
+	if (UnHIDBulkTransfer && !UnHIDBulkTransfer->IsCompleted())
 	{
-		ErrorMessage = "Empty UnHIDDeviceInfo Path";
+		ErrorMessage = "Bulk transfer in progress";
 		return false;
 	}
 
-	HidDevice = hid_open_path(TCHAR_TO_UTF8(*UnHIDDeviceInfo.Path));
-	if (!HidDevice)
+	if (BulkTransferOptions.WindowSize > 0 && !UnHIDResponseMatcher)
 	{
-		ErrorMessage = WCHAR_TO_TCHAR(hid_error(nullptr));
+		ErrorMessage = "Reader not started";
 		return false;
 	}
 
-	ReportDescriptor = MakeShared<TArray<uint8>>();
-	ReportDescriptor->AddUninitialized(HID_API_MAX_REPORT_DESCRIPTOR_SIZE);
-
-	const int32 ReportDescriptorSize = hid_get_report_descriptor(reinterpret_cast<hid_device*>(HidDevice), ReportDescriptor->GetData(), ReportDescriptor->Num());
-
-	if (ReportDescriptorSize > 0)
+	if (!DescriptorReports.IsValid())
 	{
-		ReportDescriptor->SetNum(ReportDescriptorSize);
+		ErrorMessage = "Invalid Report Descriptor";
+		return false;
 	}
-	else
+
+	const TArray<FUnHIDDeviceDescriptorReport>& Reports = BulkTransferOptions.bFeatureReports ? DescriptorReports->Features : DescriptorReports->Outputs;
+	const FUnHIDDeviceDescriptorReport* Report = Reports.FindByPredicate([&BulkTransferOptions](const FUnHIDDeviceDescriptorReport& DescriptorReport) { return DescriptorReport.ReportId == BulkTransferOptions.ReportId; });
+	if (!Report || Report->NumBytes < 1)
 	{
-		ReportDescriptor = nullptr;
+		ErrorMessage = FString::Printf(TEXT("Unknown %s Report %u"), BulkTransferOptions.bFeatureReports ? TEXT("Feature") : TEXT("Output"), BulkTransferOptions.ReportId);
+		return false;
 	}
 
-	hid_device_info* HidDeviceInfo = hid_get_device_info(reinterpret_cast<hid_device*>(HidDevice));
-	if (HidDeviceInfo)
+	// the previous one has already completed
+	if (UnHIDBulkTransfer)
 	{
-		DeviceInfo = MakeShared<FUnHIDDeviceInfo>();
-		UnHID::FillDeviceInfo(HidDeviceInfo, *DeviceInfo);
+		delete UnHIDBulkTransfer;
 	}
 
-	UnHIDDeviceWorkerThread = new FUnHIDDeviceWorkerThread(TWeakObjectPtr<UUnHIDDevice>(this), reinterpret_cast<hid_device*>(HidDevice), InReadNativeDelegate);
+	UnHIDBulkTransfer = new FUnHIDBulkTransfer(this, UnHIDResponseMatcher, Data, BulkTransferOptions, Report->NumBytes, OnBulkTransferCompleted);
 
 	return true;
 }
 
-UUnHIDDevice::~UUnHIDDevice()
+void UUnHIDDevice::CancelBulkTransfer()
 {
-	Terminate();
+	if (UnHIDBulkTransfer)
+	{
+		UnHIDBulkTransfer->Stop();
+	}
 }
 
-void UUnHIDDevice::StopWorkerThread()
+FUnHIDBulkTransferStats UUnHIDDevice::GetBulkTransferStats() const
 {
-	if (UnHIDDeviceWorkerThread)
+	FUnHIDBulkTransferStats BulkTransferStats;
+	if (UnHIDBulkTransfer)
 	{
-		UnHIDDeviceWorkerThread->Stop();
+		UnHIDBulkTransfer->GetBulkTransferStats(BulkTransferStats);
 	}
+	return BulkTransferStats;
 }
 
-void UUnHIDDevice::Terminate()
+bool UUnHIDDevice::StartFeatureReportPolling(const uint8 ReportId, const int32 Size, const float IntervalSeconds, const FUnHIDReadResultDynamicDelegate& OnReportChanged, int32& PollHandle, FString& ErrorMessage)
 {
-	StopWorkerThread();
+	FUnHIDReadResultNativeDelegate OnReportChangedNative;
+	OnReportChangedNative.BindLambda([OnReportChanged](UUnHIDDevice* UnHIDDevice, const FUnHIDReadResult& ReadResult)
+		{
+			OnReportChanged.ExecuteIfBound(UnHIDDevice, ReadResult);
+		});
 
-	if (UnHIDDeviceWorkerThread)
+	return StartFeatureReportPolling(ReportId, Size, IntervalSeconds, OnReportChangedNative, PollHandle, ErrorMessage);
+}
+
+bool UUnHIDDevice::StartFeatureReportPolling(const uint8 ReportId, const int32 Size, const float IntervalSeconds, const FUnHIDReadResultNativeDelegate& OnReportChanged, int32& PollHandle, FString& ErrorMessage)
+{
+	if (!HidDevice)
 	{
-		delete UnHIDDeviceWorkerThread;
+		ErrorMessage = "Invalid HidDevice";
+		return false;
 	}
 
-	UnHIDDeviceWorkerThread = nullptr;
+	if (IntervalSeconds <= 0)
+	{
+		ErrorMessage = "Invalid IntervalSeconds";
+		return false;
+	}
 
-	if (HidDevice)
+	int32 ReportSize = Size;
+	if (ReportSize <= 0)
 	{
-		hid_close(reinterpret_cast<hid_device*>(HidDevice));
+		TArray<int32> Sizes;
+		if (!GetFeatureReportsSizes({ ReportId }, Sizes, ErrorMessage))
+		{
+			return false;
+		}
+		ReportSize = Sizes[0];
 	}
 
-	HidDevice = nullptr;
+	PollHandle = FUnHIDFeaturePollScheduler::Get().Register(this, ReportId, ReportSize, IntervalSeconds, OnReportChanged);
+
+	return true;
 }
 
-bool UUnHIDDevice::WriteBytes(const TArray<uint8>& Bytes, FString& ErrorMessage)
+bool UUnHIDDevice::StopFeatureReportPolling(const int32 PollHandle)
 {
-	if (!HidDevice)
+	FUnHIDFeaturePollScheduler* FeaturePollScheduler = FUnHIDFeaturePollScheduler::GetPtr();
+	if (!FeaturePollScheduler)
 	{
-		ErrorMessage = "Invalid HidDevice";
 		return false;
 	}
 
-	const int32 WriteSize = hid_write(reinterpret_cast<hid_device*>(HidDevice), Bytes.GetData(), Bytes.Num());
-	if (WriteSize <= 0)
+	return FeaturePollScheduler->Unregister(this, PollHandle);
+}
+
+FUnHIDDeviceWriteStats UUnHIDDevice::GetWriteStats() const
+{
+	FUnHIDDeviceWriteStats WriteStats;
+	if (UnHIDDeviceWriter)
 	{
-		ErrorMessage = WCHAR_TO_TCHAR(hid_error(reinterpret_cast<hid_device*>(HidDevice)));
-		return false;
+		UnHIDDeviceWriter->GetWriteStats(WriteStats);
 	}
 
-	return true;
+	return WriteStats;
 }
 
 bool UUnHIDDevice::WriteHexString(const FString& HexString, FString& ErrorMessage)
@@ -263,6 +1017,8 @@ bool UUnHIDDevice::GetFeatureReportBytes(const uint8 ReportId, const int32 Size,
 
 	Bytes[0] = ReportId;
 
+	FScopeLock Lock(&HidDeviceLock);
+
 	const int32 ReportSize = hid_get_feature_report(reinterpret_cast<hid_device*>(HidDevice), Bytes.GetData(), Bytes.Num());
 	if (ReportSize <= 0)
 	{
@@ -296,6 +1052,8 @@ bool UUnHIDDevice::SetFeatureReportBytes(const TArray<uint8>& Bytes, FString& Er
 		return false;
 	}
 
+	FScopeLock Lock(&HidDeviceLock);
+
 	const int32 WriteSize = hid_send_feature_report(reinterpret_cast<hid_device*>(HidDevice), Bytes.GetData(), Bytes.Num());
 	if (WriteSize <= 0)
 	{
@@ -322,6 +1080,8 @@ FString UUnHIDDevice::GetSerialNumberString(FString& ErrorMessage)
 	TArray<wchar_t> SerialNumberBuffer;
 	SerialNumberBuffer.AddZeroed(256);
 
+	FScopeLock Lock(&HidDeviceLock);
+
 	int32 Result = hid_get_serial_number_string(reinterpret_cast<hid_device*>(HidDevice), SerialNumberBuffer.GetData(), 256);
 	if (Result < 0)
 	{
@@ -352,7 +1112,29 @@ FUnHIDDeviceInfo UUnHIDDevice::GetDeviceInfo() const
 	return FUnHIDDeviceInfo();
 }
 
-bool UUnHIDDevice::GetDescriptorReports(struct FUnHIDDeviceDescriptorReports& DeviceDescriptorReports, FString& ErrorMessage)
+FUnHIDDeviceReadStats UUnHIDDevice::GetReadStats() const
+{
+	FUnHIDDeviceReadStats ReadStats;
+	if (UnHIDDeviceReader)
+	{
+		UnHIDDeviceReader->GetReadStats(ReadStats);
+	}
+
+	return ReadStats;
+}
+
+int64 UUnHIDDevice::GetBufferSize() const
+{
+	int64 BufferSize = ReadReport.GetAllocatedSize() + ReadReportBatch.Data.GetAllocatedSize() + ReadReportBatch.Offsets.GetAllocatedSize() + ReadReportBatch.Sizes.GetAllocatedSize() + ReadReportBatch.Timestamps.GetAllocatedSize();
+	if (UnHIDDeviceReader)
+	{
+		BufferSize += UnHIDDeviceReader->GetBufferSize();
+	}
+
+	return BufferSize;
+}
+
+bool UUnHIDDevice::ParseDescriptorReports(FString& ErrorMessage)
 {
 	if (!ReportDescriptor.IsValid())
 	{
@@ -362,15 +1144,38 @@ bool UUnHIDDevice::GetDescriptorReports(struct FUnHIDDeviceDescriptorReports& De
 
 	if (!DescriptorReports.IsValid())
 	{
-		const FUnHIDDeviceDescriptorReports NewDescriptorReports = UUnHIDBlueprintFunctionLibrary::UnHIDGetReportsFromReportDescriptorBytes(*ReportDescriptor, ErrorMessage);
-		if (NewDescriptorReports.bValid)
+		// known devices are not parsed again
+		if (DeviceInfo.IsValid())
 		{
-			DescriptorReports = MakeShared<FUnHIDDeviceDescriptorReports>(NewDescriptorReports);
+			DescriptorReports = FUnHIDDescriptorCache::Get().GetOrParseDescriptorReports(*DeviceInfo, *ReportDescriptor, ErrorMessage);
 		}
 		else
+		{
+			FUnHIDDeviceDescriptorReports NewDescriptorReports = UUnHIDBlueprintFunctionLibrary::UnHIDGetReportsFromReportDescriptorBytes(*ReportDescriptor, ErrorMessage);
+			if (NewDescriptorReports.bValid)
+			{
+				DescriptorReports = MakeShared<const FUnHIDDeviceDescriptorReports>(MoveTemp(NewDescriptorReports));
+			}
+		}
+
+		if (!DescriptorReports.IsValid())
 		{
 			return false;
 		}
+
+		// the usage lookups of the parse functions never scan the reports
+		UsageIndex = MakeShared<const FUnHIDUsageIndex>(*DescriptorReports);
+		ReportDecoder = MakeShared<const FUnHIDReportDecoder>(*DescriptorReports);
+	}
+
+	return true;
+}
+
+bool UUnHIDDevice::GetDescriptorReports(struct FUnHIDDeviceDescriptorReports& DeviceDescriptorReports, FString& ErrorMessage)
+{
+	if (!ParseDescriptorReports(ErrorMessage))
+	{
+		return false;
 	}
 
 	DeviceDescriptorReports = *DescriptorReports;
@@ -378,37 +1183,214 @@ bool UUnHIDDevice::GetDescriptorReports(struct FUnHIDDeviceDescriptorReports& De
 	return true;
 }
 
-bool UUnHIDDevice::GetBitOffsetAndSizeFromDescriptorReportsAndUsage(const int32 UsagePage, const int32 Usage, int64& BitOffset, int64& BitSize, FString& ErrorMessage)
+TSharedPtr<const FUnHIDDeviceDescriptorReports> UUnHIDDevice::GetDescriptorReportsShared(FString& ErrorMessage)
+{
+	if (!ParseDescriptorReports(ErrorMessage))
+	{
+		return nullptr;
+	}
+
+	return DescriptorReports;
+}
+
+TSharedPtr<const FUnHIDUsageIndex> UUnHIDDevice::GetUsageIndex(FString& ErrorMessage)
+{
+	if (!ParseDescriptorReports(ErrorMessage))
+	{
+		return nullptr;
+	}
+
+	return UsageIndex;
+}
+
+TSharedPtr<const FUnHIDReportDecoder> UUnHIDDevice::GetReportDecoder(FString& ErrorMessage)
+{
+	if (!ParseDescriptorReports(ErrorMessage))
+	{
+		return nullptr;
+	}
+
+	return ReportDecoder;
+}
+
+bool UUnHIDDevice::DecodeReport(const TArray<uint8>& Bytes, FUnHIDDecodedReport& DecodedReport, FString& ErrorMessage)
 {
-	FUnHIDDeviceDescriptorReports DeviceDescriptorReports;
-	if (!GetDescriptorReports(DeviceDescriptorReports, ErrorMessage))
+	if (!ParseDescriptorReports(ErrorMessage))
 	{
 		return false;
 	}
 
-	return UUnHIDBlueprintFunctionLibrary::UnHIDGetBitOffsetAndSizeFromDescriptorReportsAndUsage(DeviceDescriptorReports.Inputs, UsagePage, Usage, BitOffset, BitSize);
+	if (!ReportDecoder->Decode(Bytes, DecodedReport))
+	{
+		ErrorMessage = "Unknown Input Report";
+		return false;
+	}
+
+	return true;
 }
 
-bool UUnHIDDevice::ParseAnalogFromBytesAndUsageChecked(const TArray<uint8>& Bytes, const int32 UsagePage, const int32 Usage, const float AnalogMin, const float AnalogMax, float& Value, FString& ErrorMessage)
+bool UUnHIDDevice::GetDecodedUsage(const FUnHIDDecodedReport& DecodedReport, const int32 UsagePage, const int32 Usage, int64& Value, float& NormalizedValue) const
+{
+	Value = 0;
+	NormalizedValue = 0;
+
+	// the decoder exists only if a report has already been decoded
+	if (!ReportDecoder.IsValid())
+	{
+		return false;
+	}
+
+	return ReportDecoder->GetUsage(DecodedReport, UsagePage, Usage, Value, NormalizedValue);
+}
+
+bool UUnHIDDevice::CanStartChangeDetection(FString& ErrorMessage)
 {
-	FUnHIDDeviceDescriptorReports DeviceDescriptorReports;
-	if (!GetDescriptorReports(DeviceDescriptorReports, ErrorMessage))
+	if (!HidDevice)
+	{
+		ErrorMessage = "Invalid HidDevice";
+		return false;
+	}
+
+	// the previous reports live on the game thread
+	if (ReadAnyThreadNativeDelegate.IsBound())
 	{
+		ErrorMessage = "Change detection is not available with the AnyThread delegate";
 		return false;
 	}
 
-	FUnHIDDeviceDescriptorReportItem DescriptorReportItem;
+	if (!ParseDescriptorReports(ErrorMessage))
+	{
+		return false;
+	}
 
-	if (!UUnHIDBlueprintFunctionLibrary::UnHIDGetDescriptorReportItemFromDescriptorReportsAndUsage(DeviceDescriptorReports.Inputs, UsagePage, Usage, DescriptorReportItem))
+	if (PreviousReports.Num() == 0)
 	{
-		if (!UUnHIDBlueprintFunctionLibrary::UnHIDGetDescriptorReportItemFromDescriptorReportsAndUsage(DeviceDescriptorReports.Features, UsagePage, Usage, DescriptorReportItem))
+		PreviousReports.SetNum(256);
+	}
+
+	return true;
+}
+
+bool UUnHIDDevice::StartChangeDetection(const FUnHIDUsagesChangedDynamicDelegate& OnUsagesChanged, FString& ErrorMessage)
+{
+	FUnHIDUsagesChangedNativeDelegate OnUsagesChangedNative;
+	OnUsagesChangedNative.BindLambda([OnUsagesChanged](UUnHIDDevice* UnHIDDevice, const TArray<FUnHIDChangedUsage>& ChangedUsages)
 		{
-			ErrorMessage = "Usage not found in Report Descriptor";
-			return false;
-		}
+			OnUsagesChanged.ExecuteIfBound(UnHIDDevice, ChangedUsages);
+		});
+
+	return StartChangeDetection(OnUsagesChangedNative, ErrorMessage);
+}
+
+bool UUnHIDDevice::StartChangeDetection(const FUnHIDUsagesChangedNativeDelegate& OnUsagesChanged, FString& ErrorMessage)
+{
+	if (!CanStartChangeDetection(ErrorMessage))
+	{
+		return false;
+	}
+
+	UsagesChangedNativeDelegate = OnUsagesChanged;
+
+	return true;
+}
+
+bool UUnHIDDevice::StartUsageChangeDetection(const FUnHIDUsageChangedDynamicDelegate& OnUsageChanged, FString& ErrorMessage)
+{
+	FUnHIDUsageChangedNativeDelegate OnUsageChangedNative;
+	OnUsageChangedNative.BindLambda([OnUsageChanged](UUnHIDDevice* UnHIDDevice, const FUnHIDChangedUsage& ChangedUsage)
+		{
+			OnUsageChanged.ExecuteIfBound(UnHIDDevice, ChangedUsage);
+		});
+
+	return StartUsageChangeDetection(OnUsageChangedNative, ErrorMessage);
+}
+
+bool UUnHIDDevice::StartUsageChangeDetection(const FUnHIDUsageChangedNativeDelegate& OnUsageChanged, FString& ErrorMessage)
+{
+	if (!CanStartChangeDetection(ErrorMessage))
+	{
+		return false;
+	}
+
+	UsageChangedNativeDelegate = OnUsageChanged;
+
+	return true;
+}
+
+void UUnHIDDevice::StopChangeDetection()
+{
+	UsagesChangedNativeDelegate.Unbind();
+	UsageChangedNativeDelegate.Unbind();
+
+	for (TArray<uint8>& PreviousReport : PreviousReports)
+	{
+		PreviousReport.Reset();
+	}
+}
+
+bool UUnHIDDevice::DetectChanges(TArrayView<const uint8> Report)
+{
+	if (!ReportDecoder.IsValid() || Report.Num() < 1 || PreviousReports.Num() == 0)
+	{
+		return true;
+	}
+
+	// the first report of an id is compared with an all zeros report
+	TArray<uint8>& PreviousReport = PreviousReports[ReportDecoder->HasReportIds() ? Report[0] : 0];
+	const bool bKnownReport = ReportDecoder->FindChangedUsages(PreviousReport, Report, ChangedUsages);
+	PreviousReport.Reset();
+	PreviousReport.Append(Report.GetData(), Report.Num());
+
+	if (!bKnownReport || ChangedUsages.Num() == 0)
+	{
+		return true;
+	}
+
+	UsagesChangedNativeDelegate.ExecuteIfBound(this, ChangedUsages);
+
+	// the delegates could have terminated the device (or stopped the change detection)
+	for (int32 ChangedUsageIndex = 0; ChangedUsageIndex < ChangedUsages.Num() && UnHIDDeviceReader && UsageChangedNativeDelegate.IsBound(); ChangedUsageIndex++)
+	{
+		UsageChangedNativeDelegate.Execute(this, ChangedUsages[ChangedUsageIndex]);
+	}
+
+	return UnHIDDeviceReader != nullptr;
+}
+
+bool UUnHIDDevice::GetBitOffsetAndSizeFromDescriptorReportsAndUsage(const int32 UsagePage, const int32 Usage, int64& BitOffset, int64& BitSize, FString& ErrorMessage)
+{
+	if (!ParseDescriptorReports(ErrorMessage))
+	{
+		return false;
+	}
+
+	FUnHIDUsageLocation UsageLocation;
+	if (!UsageIndex->FindInput(UsagePage, Usage, UsageLocation))
+	{
+		return false;
+	}
+
+	BitOffset = UsageLocation.BitOffset;
+	BitSize = UsageLocation.BitSize;
+	return true;
+}
+
+bool UUnHIDDevice::ParseAnalogFromBytesAndUsageChecked(const TArray<uint8>& Bytes, const int32 UsagePage, const int32 Usage, const float AnalogMin, const float AnalogMax, float& Value, FString& ErrorMessage)
+{
+	if (!ParseDescriptorReports(ErrorMessage))
+	{
+		return false;
 	}
 
-	Value = UUnHIDBlueprintFunctionLibrary::UnHIDParseAnalogFromBytes(Bytes, DescriptorReportItem.BitOffset, DescriptorReportItem.BitSize, DescriptorReportItem.LogicalMinimum, DescriptorReportItem.LogicalMaximum, AnalogMin, AnalogMax);
+	// inputs first, then features
+	FUnHIDUsageLocation UsageLocation;
+	if (!UsageIndex->Find(UsagePage, Usage, UsageLocation))
+	{
+		ErrorMessage = "Usage not found in Report Descriptor";
+		return false;
+	}
+
+	Value = UUnHIDBlueprintFunctionLibrary::UnHIDParseAnalogFromBytes(Bytes, UsageLocation.BitOffset, UsageLocation.BitSize, UsageLocation.LogicalMinimum, UsageLocation.LogicalMaximum, AnalogMin, AnalogMax);
 	return true;
 }
 
@@ -426,25 +1408,20 @@ float UUnHIDDevice::ParseAnalogFromBytesAndUsage(const TArray<uint8>& Bytes, con
 
 bool UUnHIDDevice::ParseUnsignedIntegerFromBytesAndUsageChecked(const TArray<uint8>& Bytes, const int32 UsagePage, const int32 Usage, int64& Value, FString& ErrorMessage)
 {
-	FUnHIDDeviceDescriptorReports DeviceDescriptorReports;
-	if (!GetDescriptorReports(DeviceDescriptorReports, ErrorMessage))
+	if (!ParseDescriptorReports(ErrorMessage))
 	{
 		return false;
 	}
 
-	FUnHIDDeviceDescriptorReportItem DescriptorReportItem;
-
-	if (!UUnHIDBlueprintFunctionLibrary::UnHIDGetDescriptorReportItemFromDescriptorReportsAndUsage(DeviceDescriptorReports.Inputs, UsagePage, Usage, DescriptorReportItem))
+	// inputs first, then features
+	FUnHIDUsageLocation UsageLocation;
+	if (!UsageIndex->Find(UsagePage, Usage, UsageLocation))
 	{
-		if (!UUnHIDBlueprintFunctionLibrary::UnHIDGetDescriptorReportItemFromDescriptorReportsAndUsage(DeviceDescriptorReports.Features, UsagePage, Usage, DescriptorReportItem))
-		{
-			ErrorMessage = "Usage not found in Report Descriptor";
-			return false;
-		}
+		ErrorMessage = "Usage not found in Report Descriptor";
+		return false;
 	}
 
-
-	Value = UUnHIDBlueprintFunctionLibrary::UnHIDParseUnsignedIntegerFromBytes(Bytes, DescriptorReportItem.BitOffset, DescriptorReportItem.BitSize);
+	Value = UUnHIDBlueprintFunctionLibrary::UnHIDParseUnsignedIntegerFromBytes(Bytes, UsageLocation.BitOffset, UsageLocation.BitSize);
 	return true;
 }
 
@@ -462,25 +1439,20 @@ int64 UUnHIDDevice::ParseUnsignedIntegerFromBytesAndUsage(const TArray<uint8>& B
 
 bool UUnHIDDevice::ParseSignedIntegerFromBytesAndUsageChecked(const TArray<uint8>& Bytes, const int32 UsagePage, const int32 Usage, int64& Value, FString& ErrorMessage)
 {
-	FUnHIDDeviceDescriptorReports DeviceDescriptorReports;
-	if (!GetDescriptorReports(DeviceDescriptorReports, ErrorMessage))
+	if (!ParseDescriptorReports(ErrorMessage))
 	{
 		return false;
 	}
 
-	FUnHIDDeviceDescriptorReportItem DescriptorReportItem;
-
-	if (!UUnHIDBlueprintFunctionLibrary::UnHIDGetDescriptorReportItemFromDescriptorReportsAndUsage(DeviceDescriptorReports.Inputs, UsagePage, Usage, DescriptorReportItem))
+	// inputs first, then features
+	FUnHIDUsageLocation UsageLocation;
+	if (!UsageIndex->Find(UsagePage, Usage, UsageLocation))
 	{
-		if (!UUnHIDBlueprintFunctionLibrary::UnHIDGetDescriptorReportItemFromDescriptorReportsAndUsage(DeviceDescriptorReports.Features, UsagePage, Usage, DescriptorReportItem))
-		{
-			ErrorMessage = "Usage not found in Report Descriptor";
-			return false;
-		}
+		ErrorMessage = "Usage not found in Report Descriptor";
+		return false;
 	}
 
-
-	Value = UUnHIDBlueprintFunctionLibrary::UnHIDParseSignedIntegerFromBytes(Bytes, DescriptorReportItem.BitOffset, DescriptorReportItem.BitSize);
+	Value = UUnHIDBlueprintFunctionLibrary::UnHIDParseSignedIntegerFromBytes(Bytes, UsageLocation.BitOffset, UsageLocation.BitSize);
 	return true;
 }
 
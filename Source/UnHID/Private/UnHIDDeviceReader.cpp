@@ -0,0 +1,356 @@
+// Copyright 2026 - Roberto De Ioris
+
+#include "UnHIDDeviceReader.h"
+#include "UnHIDResponseMatcher.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "hidapi.h"
+THIRD_PARTY_INCLUDES_END
+
+// platform specific hidapi extensions for waking up blocked reads
+#if PLATFORM_WINDOWS
+extern "C" int hid_winapi_interrupt_read(hid_device* dev);
+#elif PLATFORM_MAC
+extern "C" int hid_darwin_interrupt_read(hid_device* dev);
+#elif PLATFORM_LINUX
+extern "C" int hid_hidraw_interrupt_read(hid_device* dev);
+#endif
+
+namespace UnHID
+{
+	// enough for about 16 frames of a 1 kHz device at 60 fps
+	constexpr int32 DefaultMaxQueuedReports = 256;
+	constexpr int32 MaxMaxQueuedReports = 65536;
+	// historical hidraw HID_MAX_BUFFER_SIZE, used only when the report descriptor is not available
+	constexpr int32 DefaultReportSize = 4096;
+}
+
+FUnHIDDeviceReader::FUnHIDDeviceReader(hid_device* InHidDevice, const FUnHIDDeviceReadOptions& InReadOptions, const bool bInHasReportIds, const int32 InReportSize)  :
+	MaxQueuedReports(InReadOptions.QueuePolicy == EUnHIDReadQueuePolicy::Coalesce ? 1 : (InReadOptions.MaxQueuedReports > 0 ? FMath::Min(InReadOptions.MaxQueuedReports, UnHID::MaxMaxQueuedReports) : UnHID::DefaultMaxQueuedReports)),
+	bReadError(false),
+	bInterrupted(false),
+	EnqueuedReports(0),
+	DeliveredReports(0),
+	DroppedReports(0),
+	SuppressedReports(0),
+	// DropOldest is enforced by the game thread when draining, the spare slots keep the reader from blocking on it
+	ReportRing(InReadOptions.QueuePolicy == EUnHIDReadQueuePolicy::DropOldest ? MaxQueuedReports * 2 : MaxQueuedReports, InReportSize > 0 ? InReportSize : UnHID::DefaultReportSize)
+{
+	HidDevice = InHidDevice;
+	ReadOptions = InReadOptions;
+	bHasReportIds = bInHasReportIds;
+	ScratchBuffer.AddZeroed(ReportRing.GetSlotSize());
+	if (ReadOptions.QueuePolicy == EUnHIDReadQueuePolicy::Coalesce)
+	{
+		// the ring is not used when coalescing
+		CoalescedReports.AddDefaulted(bHasReportIds ? 256 : 1);
+	}
+
+	if (ReadOptions.bSkipIdenticalReports)
+	{
+		LastReports.AddDefaulted(bHasReportIds ? 256 : 1);
+	}
+}
+
+int64 FUnHIDDeviceReader::GetBufferSize() const
+{
+	int64 BufferSize = ReportRing.GetBufferSize() + ScratchBuffer.GetAllocatedSize();
+	// the content of LastReports is owned by the reader thread and not counted
+	BufferSize += LastReports.GetAllocatedSize();
+
+	FScopeLock Lock(&CoalescedReportsLock);
+	BufferSize += CoalescedReports.GetAllocatedSize();
+	for (const FUnHIDCoalescedReport& CoalescedReport : CoalescedReports)
+	{
+		BufferSize += CoalescedReport.Data.GetAllocatedSize();
+	}
+	return BufferSize;
+}
+
+void FUnHIDDeviceReader::SetAnyThreadDelegate(UUnHIDDevice* InDevice, const FUnHIDReadAnyThreadNativeDelegate& InAnyThreadDelegate)
+{
+	AnyThreadDevice = InDevice;
+	AnyThreadDelegate = InAnyThreadDelegate;
+}
+
+void FUnHIDDeviceReader::SetResponseMatcher(FUnHIDResponseMatcher* InResponseMatcher)
+{
+	ResponseMatcher = InResponseMatcher;
+}
+
+int32 FUnHIDDeviceReader::ReadReport(const int32 Milliseconds)
+{
+	if (!ReadOptions.bDrainOnWakeup)
+	{
+		return ReadOneReport(Milliseconds, true);
+	}
+
+	const int32 ReadSize = ReadOneReport(Milliseconds, false);
+	if (ReadSize <= 0)
+	{
+		return ReadSize;
+	}
+
+	// empty the device queue without blocking (bounded, a very fast device could never leave it empty)
+	int32 DrainSize = 0;
+	for (int32 DrainIndex = 0; DrainIndex < MaxQueuedReports; DrainIndex++)
+	{
+		DrainSize = ReadOneReport(0, false);
+		if (DrainSize <= 0)
+		{
+			break;
+		}
+	}
+
+	// the whole burst becomes visible to the game thread at once (reports overflowing the ring are never published on their own)
+	ReportRing.Publish();
+
+	return DrainSize < 0 ? DrainSize : ReadSize;
+}
+
+int32 FUnHIDDeviceReader::ReadOneReport(const int32 Milliseconds, const bool bPublish)
+{
+	if (bReadError || bInterrupted)
+	{
+		return -1;
+	}
+
+	bool bOverflow = false;
+	uint8* ReadBuffer = AcquireReadBuffer(bOverflow);
+
+	const int32 ReadSize = hid_read_timeout(HidDevice, ReadBuffer, ReportRing.GetSlotSize(), Milliseconds);
+	const uint64 Timestamp = FPlatformTime::Cycles64();
+	if (ReadSize < 0)
+	{
+		// a requested wakeup is not a device error
+		if (bInterrupted)
+		{
+			return ReadSize;
+		}
+		ReadErrorMessage = WCHAR_TO_TCHAR(hid_read_error(HidDevice));
+		bReadError = true;
+		if (AnyThreadDelegate.IsBound())
+		{
+			AnyThreadDelegate.Execute(AnyThreadDevice, TArrayView<const uint8>(), static_cast<int64>(Timestamp), ReadErrorMessage);
+		}
+		return ReadSize;
+	}
+	else if (ReadSize == 0)
+	{
+		// timeout
+		return 0;
+	}
+
+	DispatchReport(ReadBuffer, ReadSize, Timestamp, bOverflow, bPublish);
+
+	return ReadSize;
+}
+
+void FUnHIDDeviceReader::InjectReport(const uint8* Data, const int32 Size, const uint64 Timestamp)
+{
+	if (Size <= 0)
+	{
+		return;
+	}
+
+	bool bOverflow = false;
+	uint8* ReadBuffer = AcquireReadBuffer(bOverflow);
+
+	// truncated like hid_read_timeout() does
+	const int32 ReadSize = FMath::Min(Size, ReportRing.GetSlotSize());
+	FMemory::Memcpy(ReadBuffer, Data, ReadSize);
+
+	DispatchReport(ReadBuffer, ReadSize, Timestamp, bOverflow, true);
+}
+
+uint8* FUnHIDDeviceReader::AcquireReadBuffer(bool& bOverflow)
+{
+	// read directly into the ring, if the queue is full read into the scratch buffer and apply the queue policy
+	const bool bAnyThread = AnyThreadDelegate.IsBound();
+	const bool bCoalesce = !bAnyThread && ReadOptions.QueuePolicy == EUnHIDReadQueuePolicy::Coalesce;
+	// with DropOldest the ring can grow beyond MaxQueuedReports, the oldest reports are discarded when draining
+	const int32 MaxCommittedReports = ReadOptions.QueuePolicy == EUnHIDReadQueuePolicy::DropOldest ? ReportRing.GetNumSlots() : MaxQueuedReports;
+	uint8* ReadBuffer = (bAnyThread || bCoalesce || ReportRing.NumCommitted() >= MaxCommittedReports) ? nullptr : ReportRing.GetWriteSlot();
+	bOverflow = ReadBuffer == nullptr;
+	return bOverflow ? ScratchBuffer.GetData() : ReadBuffer;
+}
+
+void FUnHIDDeviceReader::DispatchReport(uint8* ReadBuffer, const int32 ReadSize, const uint64 Timestamp, const bool bOverflow, const bool bPublish)
+{
+	const bool bAnyThread = AnyThreadDelegate.IsBound();
+	const bool bCoalesce = !bAnyThread && ReadOptions.QueuePolicy == EUnHIDReadQueuePolicy::Coalesce;
+
+	// responses are still delivered to the read delegates
+	if (ResponseMatcher && ResponseMatcher->HasPendingResponses())
+	{
+		ResponseMatcher->MatchReport(ReadBuffer, ReadSize, Timestamp);
+	}
+
+	// the ring slot (if any) is not committed, so it will be reused by the next read
+	if (LastReports.Num() > 0 && IsIdenticalToLastReport(ReadBuffer, ReadSize))
+	{
+		SuppressedReports++;
+		return;
+	}
+
+	bool bDropped = false;
+	if (bAnyThread)
+	{
+		EnqueuedReports++;
+		AnyThreadDelegate.Execute(AnyThreadDevice, TArrayView<const uint8>(ReadBuffer, ReadSize), static_cast<int64>(Timestamp), "");
+		DeliveredReports++;
+	}
+	else if (bCoalesce)
+	{
+		CoalesceReport(ReadBuffer, ReadSize, Timestamp);
+	}
+	else if (!bOverflow)
+	{
+		ReportRing.CommitWriteSlot(ReadSize, Timestamp, bPublish);
+		EnqueuedReports++;
+	}
+	else
+	{
+		// with DropOldest the ring is full only when the game thread has not drained it for a long time
+		DroppedReports++;
+		bDropped = true;
+	}
+
+	// a dropped report never reached the consumer, so its next copy must not be suppressed
+	if (LastReports.Num() > 0 && !bDropped)
+	{
+		RememberLastReport(ReadBuffer, ReadSize);
+	}
+}
+
+void FUnHIDDeviceReader::Interrupt()
+{
+	bInterrupted = true;
+#if PLATFORM_WINDOWS
+	hid_winapi_interrupt_read(HidDevice);
+#elif PLATFORM_MAC
+	hid_darwin_interrupt_read(HidDevice);
+#elif PLATFORM_LINUX
+	hid_hidraw_interrupt_read(HidDevice);
+#endif
+}
+
+void FUnHIDDeviceReader::CollectReports(FUnHIDReportBatch& ReportBatch)
+{
+	const int32 FirstReport = ReportBatch.Num();
+	CollectQueuedReports(ReportBatch);
+	DeliveredReports += ReportBatch.Num() - FirstReport;
+}
+
+void FUnHIDDeviceReader::CollectQueuedReports(FUnHIDReportBatch& ReportBatch)
+{
+	if (ReadOptions.QueuePolicy == EUnHIDReadQueuePolicy::Coalesce)
+	{
+		FScopeLock Lock(&CoalescedReportsLock);
+		for (FUnHIDCoalescedReport& CoalescedReport : CoalescedReports)
+		{
+			if (CoalescedReport.bPending)
+			{
+				ReportBatch.Add(CoalescedReport.Data.GetData(), CoalescedReport.Data.Num(), CoalescedReport.Timestamp);
+				CoalescedReport.bPending = false;
+			}
+		}
+		NumPendingCoalescedReports = 0;
+		return;
+	}
+
+	// only the reports available at the beginning of the tick, otherwise a fast device could starve the frame
+	int32 NumReports = ReportRing.Num();
+
+	// the reader thread never pops, so DropOldest is applied here
+	if (ReadOptions.QueuePolicy == EUnHIDReadQueuePolicy::DropOldest && NumReports > MaxQueuedReports)
+	{
+		ReportRing.Discard(NumReports - MaxQueuedReports);
+		DroppedReports += NumReports - MaxQueuedReports;
+		NumReports = MaxQueuedReports;
+	}
+
+	const uint8* Data = nullptr;
+	int32 Size = 0;
+	uint64 Timestamp = 0;
+	while (NumReports-- > 0 && ReportRing.Peek(Data, Size, Timestamp))
+	{
+		ReportBatch.Add(Data, Size, Timestamp);
+		ReportRing.Pop();
+	}
+}
+
+bool FUnHIDDeviceReader::HasPendingReports()
+{
+	return GetNumPendingReports() > 0;
+}
+
+int32 FUnHIDDeviceReader::GetNumPendingReports() const
+{
+	if (ReadOptions.QueuePolicy == EUnHIDReadQueuePolicy::Coalesce)
+	{
+		FScopeLock Lock(&CoalescedReportsLock);
+		return NumPendingCoalescedReports;
+	}
+
+	// the reports beyond MaxQueuedReports will be dropped by the next drain
+	return FMath::Min(ReportRing.Num(), MaxQueuedReports);
+}
+
+void FUnHIDDeviceReader::GetReadStats(FUnHIDDeviceReadStats& ReadStats) const
+{
+	ReadStats.EnqueuedReports = static_cast<int64>(EnqueuedReports.Load());
+	ReadStats.DeliveredReports = static_cast<int64>(DeliveredReports.Load());
+	ReadStats.DroppedReports = static_cast<int64>(DroppedReports.Load());
+	ReadStats.SuppressedReports = static_cast<int64>(SuppressedReports.Load());
+	ReadStats.QueuedReports = GetNumPendingReports();
+}
+
+bool FUnHIDDeviceReader::GetReadError(FString& ErrorMessage) const
+{
+	if (!bReadError)
+	{
+		return false;
+	}
+
+	ErrorMessage = ReadErrorMessage;
+	return true;
+}
+
+void FUnHIDDeviceReader::CoalesceReport(const uint8* Data, const int32 Size, const uint64 Timestamp)
+{
+	// without report ids the whole device is a single report
+	const int32 ReportKey = bHasReportIds ? Data[0] : 0;
+
+	FScopeLock Lock(&CoalescedReportsLock);
+	FUnHIDCoalescedReport& CoalescedReport = CoalescedReports[ReportKey];
+	// the allocation happens only the first time a report id is seen
+	CoalescedReport.Data.Reset();
+	CoalescedReport.Data.Append(Data, Size);
+	CoalescedReport.Timestamp = Timestamp;
+	if (!CoalescedReport.bPending)
+	{
+		CoalescedReport.bPending = true;
+		NumPendingCoalescedReports++;
+	}
+	else
+	{
+		// the previous value has never been delivered
+		DroppedReports++;
+	}
+	EnqueuedReports++;
+}
+
+bool FUnHIDDeviceReader::IsIdenticalToLastReport(const uint8* Data, const int32 Size) const
+{
+	const TArray<uint8>& LastReport = LastReports[bHasReportIds ? Data[0] : 0];
+	return LastReport.Num() == Size && FMemory::Memcmp(LastReport.GetData(), Data, Size) == 0;
+}
+
+void FUnHIDDeviceReader::RememberLastReport(const uint8* Data, const int32 Size)
+{
+	TArray<uint8>& LastReport = LastReports[bHasReportIds ? Data[0] : 0];
+	// the allocation happens only the first time a report id is seen (or when the size grows)
+	LastReport.Reset();
+	LastReport.Append(Data, Size);
+}
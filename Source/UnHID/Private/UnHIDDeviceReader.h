@@ -0,0 +1,127 @@
+// Copyright 2026 - Roberto De Ioris
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnHIDDevice.h"
+#include "UnHIDReportRing.h"
+
+struct hid_device_;
+typedef struct hid_device_ hid_device;
+
+/**
+ * Input side of an opened device.
+ * ReadReport() is called by a single reader thread (the per-device worker thread or a shared reader service),
+ * while CollectReports() is called by the game thread.
+ */
+class UNHID_API FUnHIDDeviceReader
+{
+public:
+	// InReportSize is the largest input report (report id included), <= 0 for the default size
+	FUnHIDDeviceReader(hid_device* InHidDevice, const FUnHIDDeviceReadOptions& InReadOptions, const bool bInHasReportIds, const int32 InReportSize);
+
+	// before starting the reader thread: reports are passed to the delegate instead of being queued for the game thread
+	void SetAnyThreadDelegate(UUnHIDDevice* InDevice, const FUnHIDReadAnyThreadNativeDelegate& InAnyThreadDelegate);
+
+	// before starting the reader thread: every input report is checked against the requests waiting for a response
+	void SetResponseMatcher(class FUnHIDResponseMatcher* InResponseMatcher);
+
+	// reader thread only: reads (at most) one report (plus the already available ones in drain mode), returns the first hid_read_timeout() result
+	int32 ReadReport(const int32 Milliseconds);
+
+	// reader thread only: handles a report as if it had been read from the device (used by the tests, no device is needed)
+	void InjectReport(const uint8* Data, const int32 Size, const uint64 Timestamp);
+
+	// any thread: wakes up a ReadReport() blocked on the device, every following ReadReport() fails
+	void Interrupt();
+
+	bool IsInterrupted() const
+	{
+		return bInterrupted;
+	}
+
+	// game thread only
+	void CollectReports(FUnHIDReportBatch& ReportBatch);
+
+	// game thread only
+	bool HasPendingReports();
+
+	int32 GetNumPendingReports() const;
+
+	void GetReadStats(FUnHIDDeviceReadStats& ReadStats) const;
+
+	// game thread only, valid after the pending reports have been collected
+	bool GetReadError(FString& ErrorMessage) const;
+
+	uint64 GetDroppedReports() const
+	{
+		return DroppedReports;
+	}
+
+	bool HasReadError() const
+	{
+		return bReadError;
+	}
+
+	hid_device* GetHidDevice() const
+	{
+		return HidDevice;
+	}
+
+	int32 GetReportSize() const
+	{
+		return ReportRing.GetSlotSize();
+	}
+
+	// memory (in bytes) allocated for the input reports
+	int64 GetBufferSize() const;
+
+private:
+	struct FUnHIDCoalescedReport
+	{
+		TArray<uint8> Data;
+		uint64 Timestamp = 0;
+		bool bPending = false;
+	};
+
+	int32 ReadOneReport(const int32 Milliseconds, const bool bPublish);
+	// the ring write slot, or the scratch buffer (bOverflow) when the report will not be committed directly
+	uint8* AcquireReadBuffer(bool& bOverflow);
+	// response matching, duplicate suppression and queue policy
+	void DispatchReport(uint8* ReadBuffer, const int32 ReadSize, const uint64 Timestamp, const bool bOverflow, const bool bPublish);
+	void CollectQueuedReports(FUnHIDReportBatch& ReportBatch);
+	void CoalesceReport(const uint8* Data, const int32 Size, const uint64 Timestamp);
+	// reader thread only
+	bool IsIdenticalToLastReport(const uint8* Data, const int32 Size) const;
+	// reader thread only, after the report has been delivered (or queued)
+	void RememberLastReport(const uint8* Data, const int32 Size);
+
+	hid_device* HidDevice;
+	FUnHIDDeviceReadOptions ReadOptions;
+	bool bHasReportIds;
+
+	UUnHIDDevice* AnyThreadDevice = nullptr;
+	FUnHIDReadAnyThreadNativeDelegate AnyThreadDelegate;
+
+	class FUnHIDResponseMatcher* ResponseMatcher = nullptr;
+
+	int32 MaxQueuedReports;
+
+	TAtomic<bool> bReadError;
+	TAtomic<bool> bInterrupted;
+	TAtomic<uint64> EnqueuedReports;
+	TAtomic<uint64> DeliveredReports;
+	TAtomic<uint64> DroppedReports;
+	TAtomic<uint64> SuppressedReports;
+
+	FUnHIDReportRing ReportRing;
+	TArray<uint8> ScratchBuffer;
+	FString ReadErrorMessage;
+
+	// indexed by report id, accessed only by the reader thread
+	TArray<TArray<uint8>> LastReports;
+
+	mutable FCriticalSection CoalescedReportsLock;
+	TArray<FUnHIDCoalescedReport> CoalescedReports;
+	int32 NumPendingCoalescedReports = 0;
+};
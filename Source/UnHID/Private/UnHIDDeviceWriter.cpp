@@ -0,0 +1,630 @@
+// Copyright 2026 - Roberto De Ioris
+
+#include "UnHIDDeviceWriter.h"
+#include "UnHIDResponseMatcher.h"
+#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "HAL/RunnableThread.h"
+
+namespace UnHID
+{
+	// power of two
+	constexpr int32 WriteQueueNumSlots = 64;
+	// the slots grow on demand if the report descriptor is not available
+	constexpr int32 DefaultWriteReportSize = 64;
+
+	static void ToReadResult(const FUnHIDWriteResult& WriteResult, const TArray<uint8>& Bytes, FUnHIDReadResult& ReadResult)
+	{
+		ReadResult.bSuccess = WriteResult.bSuccess;
+		ReadResult.ErrorMessage = WriteResult.ErrorMessage;
+		ReadResult.QueuedTimestamp = WriteResult.QueuedTimestamp;
+		ReadResult.StartedTimestamp = WriteResult.StartedTimestamp;
+		ReadResult.CompletedTimestamp = WriteResult.CompletedTimestamp;
+		ReadResult.Bytes = Bytes;
+	}
+}
+
+FUnHIDDeviceWriter::FUnHIDDeviceWriter(UUnHIDDevice* InDevice, const int32 InReportSize, FUnHIDResponseMatcher* InResponseMatcher) : bStopThread(false)
+{
+	Device = InDevice;
+	WeakDevice = InDevice;
+	ResponseMatcher = InResponseMatcher;
+
+	Requests.AddDefaulted(UnHID::WriteQueueNumSlots);
+	for (FUnHIDWriteRequest& Request : Requests)
+	{
+		Request.Data.Reserve(InReportSize > 0 ? InReportSize : UnHID::DefaultWriteReportSize);
+	}
+
+	// the payloads are allocated the first time a report id is used
+	CoalescedWrites.AddDefaulted(256);
+	LastOutputReports.AddDefaulted(256);
+
+	WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("UnHIDDeviceWriter@%p"), this));
+}
+
+FUnHIDDeviceWriter::~FUnHIDDeviceWriter()
+{
+	Stop();
+	if (Thread)
+	{
+		Thread->WaitForCompletion();
+		delete Thread;
+	}
+
+	Thread = nullptr;
+
+	// nobody is waiting forever for a write that will never happen
+	while (RequestsTail != RequestsHead)
+	{
+		FUnHIDWriteRequest& Request = Requests[RequestsTail & (Requests.Num() - 1)];
+		FUnHIDWriteResult WriteResult;
+		WriteResult.QueuedTimestamp = static_cast<int64>(Request.QueuedTimestamp);
+		WriteResult.ErrorMessage = "Device terminated";
+		CompleteRequest(Request, WriteResult);
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+	WorkEvent = nullptr;
+}
+
+FUnHIDDeviceWriter::FUnHIDWriteRequest* FUnHIDDeviceWriter::AcquireRequest(const EUnHIDWriteType WriteType, const TArray<uint8>& Bytes, const int32 ReadSize)
+{
+	if (bStopThread || RequestsHead - RequestsTail >= static_cast<uint32>(Requests.Num()))
+	{
+		FailedWrites++;
+		return nullptr;
+	}
+
+	// the slot keeps its allocation, so after the first writes there are no more allocations
+	FUnHIDWriteRequest& Request = Requests[RequestsHead & (Requests.Num() - 1)];
+	Request.WriteType = WriteType;
+	Request.Data.Reset();
+	Request.Data.Append(Bytes);
+	Request.ReadSize = ReadSize;
+	Request.ReadBytes.Reset();
+	Request.FeatureReportsResult.Reports.Reset();
+	Request.QueuedTimestamp = FPlatformTime::Cycles64();
+
+	return &Request;
+}
+
+bool FUnHIDDeviceWriter::Enqueue(const EUnHIDWriteType WriteType, const TArray<uint8>& Bytes, const FUnHIDWriteNativeDelegate& OnWriteCompleted, FString& ErrorMessage)
+{
+	{
+		FScopeLock Lock(&RequestsLock);
+
+		FUnHIDWriteRequest* Request = AcquireRequest(WriteType, Bytes, 0);
+		if (!Request)
+		{
+			ErrorMessage = "Write queue full";
+			return false;
+		}
+
+		Request->OnWriteCompleted = OnWriteCompleted;
+		RequestsHead++;
+	}
+
+	WorkEvent->Trigger();
+
+	return true;
+}
+
+TFuture<FUnHIDWriteResult> FUnHIDDeviceWriter::Enqueue(const EUnHIDWriteType WriteType, const TArray<uint8>& Bytes)
+{
+	TFuture<FUnHIDWriteResult> Future;
+
+	{
+		FScopeLock Lock(&RequestsLock);
+
+		FUnHIDWriteRequest* Request = AcquireRequest(WriteType, Bytes, 0);
+		if (!Request)
+		{
+			FUnHIDWriteResult WriteResult;
+			WriteResult.ErrorMessage = "Write queue full";
+			TPromise<FUnHIDWriteResult> Promise;
+			Promise.SetValue(WriteResult);
+			return Promise.GetFuture();
+		}
+
+		Request->Promise.Emplace();
+		Future = Request->Promise->GetFuture();
+		RequestsHead++;
+	}
+
+	WorkEvent->Trigger();
+
+	return Future;
+}
+
+bool FUnHIDDeviceWriter::EnqueueGetFeature(const uint8 ReportId, const int32 ReadSize, const FUnHIDReadResultNativeDelegate& OnReportReceived, FString& ErrorMessage)
+{
+	{
+		FScopeLock Lock(&RequestsLock);
+
+		FUnHIDWriteRequest* Request = AcquireRequest(EUnHIDWriteType::GetFeature, { ReportId }, ReadSize);
+		if (!Request)
+		{
+			ErrorMessage = "Write queue full";
+			return false;
+		}
+
+		Request->OnReadCompleted = OnReportReceived;
+		RequestsHead++;
+	}
+
+	WorkEvent->Trigger();
+
+	return true;
+}
+
+TFuture<FUnHIDReadResult> FUnHIDDeviceWriter::EnqueueGetFeature(const uint8 ReportId, const int32 ReadSize)
+{
+	TFuture<FUnHIDReadResult> Future;
+
+	{
+		FScopeLock Lock(&RequestsLock);
+
+		FUnHIDWriteRequest* Request = AcquireRequest(EUnHIDWriteType::GetFeature, { ReportId }, ReadSize);
+		if (!Request)
+		{
+			FUnHIDReadResult ReadResult;
+			ReadResult.ErrorMessage = "Write queue full";
+			TPromise<FUnHIDReadResult> Promise;
+			Promise.SetValue(ReadResult);
+			return Promise.GetFuture();
+		}
+
+		Request->ReadPromise.Emplace();
+		Future = Request->ReadPromise->GetFuture();
+		RequestsHead++;
+	}
+
+	WorkEvent->Trigger();
+
+	return Future;
+}
+
+bool FUnHIDDeviceWriter::EnqueueFeatureReports(const TArray<uint8>& ReportIds, const TArray<int32>& ReadSizes, const FUnHIDFeatureReportsNativeDelegate& OnReportsReceived, FString& ErrorMessage)
+{
+	{
+		FScopeLock Lock(&RequestsLock);
+
+		FUnHIDWriteRequest* Request = AcquireRequest(EUnHIDWriteType::GetFeatureReports, ReportIds, 0);
+		if (!Request)
+		{
+			ErrorMessage = "Write queue full";
+			return false;
+		}
+
+		Request->ReadSizes.Reset();
+		Request->ReadSizes.Append(ReadSizes);
+		Request->OnFeatureReportsCompleted = OnReportsReceived;
+		RequestsHead++;
+	}
+
+	WorkEvent->Trigger();
+
+	return true;
+}
+
+TFuture<FUnHIDFeatureReportsResult> FUnHIDDeviceWriter::EnqueueFeatureReports(const TArray<uint8>& ReportIds, const TArray<int32>& ReadSizes)
+{
+	TFuture<FUnHIDFeatureReportsResult> Future;
+
+	{
+		FScopeLock Lock(&RequestsLock);
+
+		FUnHIDWriteRequest* Request = AcquireRequest(EUnHIDWriteType::GetFeatureReports, ReportIds, 0);
+		if (!Request)
+		{
+			FUnHIDFeatureReportsResult FeatureReportsResult;
+			FeatureReportsResult.Reports.SetNum(ReportIds.Num());
+			for (FUnHIDReadResult& ReportResult : FeatureReportsResult.Reports)
+			{
+				ReportResult.ErrorMessage = "Write queue full";
+			}
+			TPromise<FUnHIDFeatureReportsResult> Promise;
+			Promise.SetValue(FeatureReportsResult);
+			return Promise.GetFuture();
+		}
+
+		Request->ReadSizes.Reset();
+		Request->ReadSizes.Append(ReadSizes);
+		Request->FeatureReportsPromise.Emplace();
+		Future = Request->FeatureReportsPromise->GetFuture();
+		RequestsHead++;
+	}
+
+	WorkEvent->Trigger();
+
+	return Future;
+}
+
+bool FUnHIDDeviceWriter::EnqueueRequest(const TArray<uint8>& Bytes, const FUnHIDResponsePredicate& ResponsePredicate, const float TimeoutSeconds, const FUnHIDReadResultNativeDelegate& OnResponseReceived, FString& ErrorMessage)
+{
+	if (!ResponseMatcher)
+	{
+		ErrorMessage = "Reader not started";
+		return false;
+	}
+
+	{
+		FScopeLock Lock(&RequestsLock);
+
+		FUnHIDWriteRequest* Request = AcquireRequest(EUnHIDWriteType::Request, Bytes, 0);
+		if (!Request)
+		{
+			ErrorMessage = "Write queue full";
+			return false;
+		}
+
+		Request->ResponsePredicate = ResponsePredicate;
+		Request->ResponseTimeoutSeconds = TimeoutSeconds;
+		Request->OnReadCompleted = OnResponseReceived;
+		RequestsHead++;
+	}
+
+	WorkEvent->Trigger();
+
+	return true;
+}
+
+TFuture<FUnHIDReadResult> FUnHIDDeviceWriter::EnqueueRequest(const TArray<uint8>& Bytes, const FUnHIDResponsePredicate& ResponsePredicate, const float TimeoutSeconds)
+{
+	TFuture<FUnHIDReadResult> Future;
+
+	{
+		FScopeLock Lock(&RequestsLock);
+
+		FUnHIDWriteRequest* Request = ResponseMatcher ? AcquireRequest(EUnHIDWriteType::Request, Bytes, 0) : nullptr;
+		if (!Request)
+		{
+			FUnHIDReadResult ReadResult;
+			ReadResult.ErrorMessage = ResponseMatcher ? "Write queue full" : "Reader not started";
+			TPromise<FUnHIDReadResult> Promise;
+			Promise.SetValue(ReadResult);
+			return Promise.GetFuture();
+		}
+
+		Request->ResponsePredicate = ResponsePredicate;
+		Request->ResponseTimeoutSeconds = TimeoutSeconds;
+		Request->ReadPromise.Emplace();
+		Future = Request->ReadPromise->GetFuture();
+		RequestsHead++;
+	}
+
+	WorkEvent->Trigger();
+
+	return Future;
+}
+
+bool FUnHIDDeviceWriter::EnqueueCoalesced(const TArray<uint8>& Bytes, FString& ErrorMessage)
+{
+	if (bStopThread)
+	{
+		ErrorMessage = "Device terminated";
+		return false;
+	}
+
+	{
+		FScopeLock Lock(&RequestsLock);
+
+		FUnHIDCoalescedWrite& CoalescedWrite = CoalescedWrites[Bytes[0]];
+		if (CoalescedWrite.bPending)
+		{
+			SupersededWrites++;
+		}
+		else
+		{
+			CoalescedWrite.bPending = true;
+			NumPendingCoalescedWrites++;
+		}
+
+		CoalescedWrite.Data.Reset();
+		CoalescedWrite.Data.Append(Bytes);
+		CoalescedWrite.QueuedTimestamp = FPlatformTime::Cycles64();
+	}
+
+	WorkEvent->Trigger();
+
+	return true;
+}
+
+void FUnHIDDeviceWriter::SetWriteOptions(const FUnHIDDeviceWriteOptions& InWriteOptions)
+{
+	{
+		FScopeLock Lock(&RequestsLock);
+		WriteOptions = InWriteOptions;
+	}
+
+	// the rate could have been changed
+	WorkEvent->Trigger();
+}
+
+bool FUnHIDDeviceWriter::Write(const EUnHIDWriteType WriteType, const TArray<uint8>& Bytes, FString& ErrorMessage)
+{
+	if (WriteType == EUnHIDWriteType::Feature)
+	{
+		return Device->SetFeatureReportBytes(Bytes, ErrorMessage);
+	}
+
+	FUnHIDDeviceWriteOptions CurrentWriteOptions;
+	{
+		FScopeLock Lock(&RequestsLock);
+		CurrentWriteOptions = WriteOptions;
+	}
+
+	TArray<uint8>* LastOutputReport = Bytes.Num() > 0 ? &LastOutputReports[Bytes[0]] : nullptr;
+	// a request always expects its response, so it is never skipped
+	if (CurrentWriteOptions.bSkipIdenticalWrites && WriteType == EUnHIDWriteType::Output && LastOutputReport && *LastOutputReport == Bytes)
+	{
+		FScopeLock Lock(&RequestsLock);
+		SkippedWrites++;
+		return true;
+	}
+
+	if (CurrentWriteOptions.MaxWritesPerSecond > 0)
+	{
+		NextOutputCycles = FPlatformTime::Cycles64() + static_cast<uint64>(1.0 / (CurrentWriteOptions.MaxWritesPerSecond * FPlatformTime::GetSecondsPerCycle64()));
+	}
+
+	if (!Device->WriteBytes(Bytes, ErrorMessage))
+	{
+		return false;
+	}
+
+	if (LastOutputReport)
+	{
+		LastOutputReport->Reset();
+		LastOutputReport->Append(Bytes);
+	}
+
+	return true;
+}
+
+void FUnHIDDeviceWriter::Execute(FUnHIDWriteRequest& Request, FUnHIDWriteResult& WriteResult)
+{
+	if (Request.WriteType == EUnHIDWriteType::GetFeature)
+	{
+		WriteResult.bSuccess = Request.Data.Num() > 0 && Device->GetFeatureReportBytes(Request.Data[0], Request.ReadSize, Request.ReadBytes, WriteResult.ErrorMessage);
+		return;
+	}
+
+	if (Request.WriteType == EUnHIDWriteType::GetFeatureReports)
+	{
+		FUnHIDFeatureReportsResult& FeatureReportsResult = Request.FeatureReportsResult;
+		FeatureReportsResult.Reports.SetNum(Request.Data.Num());
+		FeatureReportsResult.bSuccess = true;
+		for (int32 ReportIndex = 0; ReportIndex < Request.Data.Num(); ReportIndex++)
+		{
+			FUnHIDReadResult& ReportResult = FeatureReportsResult.Reports[ReportIndex];
+			ReportResult.ErrorMessage.Reset();
+			ReportResult.QueuedTimestamp = static_cast<int64>(Request.QueuedTimestamp);
+			ReportResult.StartedTimestamp = static_cast<int64>(FPlatformTime::Cycles64());
+			ReportResult.bSuccess = Device->GetFeatureReportBytes(Request.Data[ReportIndex], Request.ReadSizes[ReportIndex], ReportResult.Bytes, ReportResult.ErrorMessage);
+			ReportResult.CompletedTimestamp = static_cast<int64>(FPlatformTime::Cycles64());
+			FeatureReportsResult.bSuccess &= ReportResult.bSuccess;
+		}
+
+		WriteResult.bSuccess = FeatureReportsResult.bSuccess;
+		return;
+	}
+
+	if (Request.WriteType == EUnHIDWriteType::Request)
+	{
+		// registered before writing, so even the fastest response is matched
+		const uint64 PendingResponseId = ResponseMatcher->Add(Request.ResponsePredicate, Request.QueuedTimestamp, Request.ResponseTimeoutSeconds, Request.OnReadCompleted, MoveTemp(Request.ReadPromise));
+		Request.OnReadCompleted.Unbind();
+		Request.ReadPromise.Reset();
+
+		WriteResult.bSuccess = Write(Request.WriteType, Request.Data, WriteResult.ErrorMessage);
+		if (!WriteResult.bSuccess)
+		{
+			ResponseMatcher->Fail(PendingResponseId, WriteResult.ErrorMessage);
+		}
+		return;
+	}
+
+	WriteResult.bSuccess = Write(Request.WriteType, Request.Data, WriteResult.ErrorMessage);
+}
+
+void FUnHIDDeviceWriter::UpdateStats(const bool bSuccess, const uint64 QueuedTimestamp, const uint64 CompletedTimestamp)
+{
+	FScopeLock Lock(&RequestsLock);
+
+	if (bSuccess)
+	{
+		const double LatencyMilliseconds = FPlatformTime::ToMilliseconds64(CompletedTimestamp - QueuedTimestamp);
+		CompletedWrites++;
+		LastLatencyMilliseconds = LatencyMilliseconds;
+		TotalLatencyMilliseconds += LatencyMilliseconds;
+		MaxLatencyMilliseconds = FMath::Max(MaxLatencyMilliseconds, LatencyMilliseconds);
+	}
+	else
+	{
+		FailedWrites++;
+	}
+}
+
+void FUnHIDDeviceWriter::CompleteRequest(FUnHIDWriteRequest& Request, FUnHIDWriteResult& WriteResult)
+{
+	const uint64 CompletedTimestamp = FPlatformTime::Cycles64();
+	WriteResult.CompletedTimestamp = static_cast<int64>(CompletedTimestamp);
+
+	if (Request.Promise.IsSet())
+	{
+		Request.Promise->SetValue(WriteResult);
+	}
+
+	if (Request.OnWriteCompleted.IsBound())
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakDevice = WeakDevice, OnWriteCompleted = Request.OnWriteCompleted, WriteResult]()
+			{
+				OnWriteCompleted.ExecuteIfBound(WeakDevice.Get(), WriteResult);
+			});
+	}
+
+	if (Request.ReadPromise.IsSet() || Request.OnReadCompleted.IsBound())
+	{
+		FUnHIDReadResult ReadResult;
+		UnHID::ToReadResult(WriteResult, Request.ReadBytes, ReadResult);
+
+		if (Request.ReadPromise.IsSet())
+		{
+			Request.ReadPromise->SetValue(ReadResult);
+		}
+
+		if (Request.OnReadCompleted.IsBound())
+		{
+			AsyncTask(ENamedThreads::GameThread, [WeakDevice = WeakDevice, OnReadCompleted = Request.OnReadCompleted, ReadResult]()
+				{
+					OnReadCompleted.ExecuteIfBound(WeakDevice.Get(), ReadResult);
+				});
+		}
+	}
+
+	if (Request.WriteType == EUnHIDWriteType::GetFeatureReports)
+	{
+		// never executed (device terminated)
+		if (Request.FeatureReportsResult.Reports.Num() != Request.Data.Num())
+		{
+			Request.FeatureReportsResult.bSuccess = false;
+			Request.FeatureReportsResult.Reports.SetNum(Request.Data.Num());
+			for (FUnHIDReadResult& ReportResult : Request.FeatureReportsResult.Reports)
+			{
+				UnHID::ToReadResult(WriteResult, {}, ReportResult);
+			}
+		}
+
+		if (Request.FeatureReportsPromise.IsSet())
+		{
+			Request.FeatureReportsPromise->SetValue(Request.FeatureReportsResult);
+		}
+
+		if (Request.OnFeatureReportsCompleted.IsBound())
+		{
+			AsyncTask(ENamedThreads::GameThread, [WeakDevice = WeakDevice, OnFeatureReportsCompleted = Request.OnFeatureReportsCompleted, FeatureReportsResult = Request.FeatureReportsResult]()
+				{
+					OnFeatureReportsCompleted.ExecuteIfBound(WeakDevice.Get(), FeatureReportsResult);
+				});
+		}
+	}
+
+	UpdateStats(WriteResult.bSuccess, Request.QueuedTimestamp, CompletedTimestamp);
+
+	FScopeLock Lock(&RequestsLock);
+
+	Request.OnWriteCompleted.Unbind();
+	Request.Promise.Reset();
+	Request.OnReadCompleted.Unbind();
+	Request.ReadPromise.Reset();
+	Request.OnFeatureReportsCompleted.Unbind();
+	Request.FeatureReportsPromise.Reset();
+	Request.ResponsePredicate.Unbind();
+	RequestsTail++;
+}
+
+void FUnHIDDeviceWriter::GetWriteStats(FUnHIDDeviceWriteStats& WriteStats) const
+{
+	FScopeLock Lock(&RequestsLock);
+
+	WriteStats.QueuedWrites = static_cast<int32>(RequestsHead - RequestsTail);
+	WriteStats.CompletedWrites = static_cast<int64>(CompletedWrites);
+	WriteStats.FailedWrites = static_cast<int64>(FailedWrites);
+	WriteStats.LastLatencyMilliseconds = LastLatencyMilliseconds;
+	WriteStats.AverageLatencyMilliseconds = CompletedWrites > 0 ? TotalLatencyMilliseconds / CompletedWrites : 0;
+	WriteStats.MaxLatencyMilliseconds = MaxLatencyMilliseconds;
+	WriteStats.SupersededWrites = static_cast<int64>(SupersededWrites);
+	WriteStats.SkippedWrites = static_cast<int64>(SkippedWrites);
+	WriteStats.QueuedWrites += NumPendingCoalescedWrites;
+}
+
+uint32 FUnHIDDeviceWriter::Run()
+{
+	while (!bStopThread)
+	{
+		// the timeouts of the requests waiting for a response are managed by this thread too
+		const uint32 ResponseTimeoutMilliseconds = ResponseMatcher ? ResponseMatcher->ExpirePendingResponses() : MAX_uint32;
+
+		FUnHIDWriteRequest* Request = nullptr;
+		bool bCoalescedWrite = false;
+		uint64 CoalescedQueuedTimestamp = 0;
+		{
+			FScopeLock Lock(&RequestsLock);
+
+			// the rate limit applies only to output reports
+			const EUnHIDWriteType NextWriteType = RequestsTail != RequestsHead ? Requests[RequestsTail & (Requests.Num() - 1)].WriteType : EUnHIDWriteType::Output;
+			const bool bOutputNext = RequestsTail != RequestsHead ? (NextWriteType == EUnHIDWriteType::Output || NextWriteType == EUnHIDWriteType::Request) : NumPendingCoalescedWrites > 0;
+			const uint64 Now = FPlatformTime::Cycles64();
+			if (bOutputNext && WriteOptions.MaxWritesPerSecond > 0 && NextOutputCycles > Now)
+			{
+				// rate limited, the coalesced writes keep being replaced in the meantime
+				const uint32 WaitMilliseconds = FMath::Max<uint32>(1, static_cast<uint32>(FPlatformTime::ToMilliseconds64(NextOutputCycles - Now)));
+				Lock.Unlock();
+				WorkEvent->Wait(FMath::Min(WaitMilliseconds, ResponseTimeoutMilliseconds));
+				continue;
+			}
+
+			if (RequestsTail != RequestsHead)
+			{
+				// the slot is owned by this thread until the tail is advanced
+				Request = &Requests[RequestsTail & (Requests.Num() - 1)];
+			}
+			else if (NumPendingCoalescedWrites > 0)
+			{
+				// round robin between the report ids
+				for (int32 Index = 0; Index < CoalescedWrites.Num(); Index++)
+				{
+					FUnHIDCoalescedWrite& CoalescedWrite = CoalescedWrites[(NextCoalescedWrite + Index) % CoalescedWrites.Num()];
+					if (CoalescedWrite.bPending)
+					{
+						// copy it, so that it can be replaced while writing
+						CoalescedWriteBuffer.Reset();
+						CoalescedWriteBuffer.Append(CoalescedWrite.Data);
+						CoalescedQueuedTimestamp = CoalescedWrite.QueuedTimestamp;
+						CoalescedWrite.bPending = false;
+						NumPendingCoalescedWrites--;
+						NextCoalescedWrite = (NextCoalescedWrite + Index + 1) % CoalescedWrites.Num();
+						bCoalescedWrite = true;
+						break;
+					}
+				}
+			}
+		}
+
+		if (bCoalescedWrite)
+		{
+			FString ErrorMessage;
+			const bool bSuccess = Write(EUnHIDWriteType::Output, CoalescedWriteBuffer, ErrorMessage);
+			UpdateStats(bSuccess, CoalescedQueuedTimestamp, FPlatformTime::Cycles64());
+			continue;
+		}
+
+		if (!Request)
+		{
+			WorkEvent->Wait(ResponseTimeoutMilliseconds);
+			continue;
+		}
+
+		FUnHIDWriteResult WriteResult;
+		WriteResult.QueuedTimestamp = static_cast<int64>(Request->QueuedTimestamp);
+		WriteResult.StartedTimestamp = static_cast<int64>(FPlatformTime::Cycles64());
+		Execute(*Request, WriteResult);
+
+		CompleteRequest(*Request, WriteResult);
+	}
+
+	return 0;
+}
+
+void FUnHIDDeviceWriter::Stop()
+{
+	bStopThread = true;
+
+	if (WorkEvent)
+	{
+		WorkEvent->Trigger();
+	}
+}
@@ -0,0 +1,135 @@
+// Copyright 2026 - Roberto De Ioris
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "UnHIDDevice.h"
+
+enum class EUnHIDWriteType : uint8
+{
+	Output,
+	Feature,
+	// the request data is the report id
+	GetFeature,
+	// the request data is the list of report ids
+	GetFeatureReports,
+	// output report completed by the first matching input report
+	Request
+};
+
+/**
+ * Output side of an opened device (output reports and feature reports, both sent and received).
+ * Writes are queued (in a preallocated queue) by any thread and executed by a dedicated writer thread,
+ * completions are notified to the game thread (delegates) or directly from the writer thread (futures).
+ */
+class FUnHIDDeviceWriter : public FRunnable
+{
+public:
+	// InReportSize is the largest output/feature report (report id included), <= 0 for the default size
+	// InResponseMatcher (optional) receives the requests waiting for a response
+	FUnHIDDeviceWriter(UUnHIDDevice* InDevice, const int32 InReportSize, class FUnHIDResponseMatcher* InResponseMatcher);
+	virtual ~FUnHIDDeviceWriter();
+
+	// any thread: returns false if the queue is full (the completion is not invoked)
+	bool Enqueue(const EUnHIDWriteType WriteType, const TArray<uint8>& Bytes, const FUnHIDWriteNativeDelegate& OnWriteCompleted, FString& ErrorMessage);
+	TFuture<FUnHIDWriteResult> Enqueue(const EUnHIDWriteType WriteType, const TArray<uint8>& Bytes);
+
+	// any thread: the feature report is read in order with the writes
+	bool EnqueueGetFeature(const uint8 ReportId, const int32 ReadSize, const FUnHIDReadResultNativeDelegate& OnReportReceived, FString& ErrorMessage);
+	TFuture<FUnHIDReadResult> EnqueueGetFeature(const uint8 ReportId, const int32 ReadSize);
+
+	// any thread: the feature reports are read back to back and returned in a single completion
+	bool EnqueueFeatureReports(const TArray<uint8>& ReportIds, const TArray<int32>& ReadSizes, const FUnHIDFeatureReportsNativeDelegate& OnReportsReceived, FString& ErrorMessage);
+	TFuture<FUnHIDFeatureReportsResult> EnqueueFeatureReports(const TArray<uint8>& ReportIds, const TArray<int32>& ReadSizes);
+
+	// any thread: the output report is written and the completion is deferred to the first input report accepted by the predicate
+	bool EnqueueRequest(const TArray<uint8>& Bytes, const FUnHIDResponsePredicate& ResponsePredicate, const float TimeoutSeconds, const FUnHIDReadResultNativeDelegate& OnResponseReceived, FString& ErrorMessage);
+	TFuture<FUnHIDReadResult> EnqueueRequest(const TArray<uint8>& Bytes, const FUnHIDResponsePredicate& ResponsePredicate, const float TimeoutSeconds);
+
+	// any thread: replaces the pending output report with the same report id (if any)
+	bool EnqueueCoalesced(const TArray<uint8>& Bytes, FString& ErrorMessage);
+
+	void SetWriteOptions(const FUnHIDDeviceWriteOptions& InWriteOptions);
+
+	void GetWriteStats(FUnHIDDeviceWriteStats& WriteStats) const;
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	struct FUnHIDWriteRequest
+	{
+		EUnHIDWriteType WriteType = EUnHIDWriteType::Output;
+		TArray<uint8> Data;
+		int32 ReadSize = 0;
+		uint64 QueuedTimestamp = 0;
+		FUnHIDWriteNativeDelegate OnWriteCompleted;
+		TOptional<TPromise<FUnHIDWriteResult>> Promise;
+
+		// GetFeature and Request only
+		FUnHIDReadResultNativeDelegate OnReadCompleted;
+		TOptional<TPromise<FUnHIDReadResult>> ReadPromise;
+		TArray<uint8> ReadBytes;
+
+		// Request only
+		FUnHIDResponsePredicate ResponsePredicate;
+		float ResponseTimeoutSeconds = 0;
+
+		// GetFeatureReports only
+		TArray<int32> ReadSizes;
+		FUnHIDFeatureReportsResult FeatureReportsResult;
+		FUnHIDFeatureReportsNativeDelegate OnFeatureReportsCompleted;
+		TOptional<TPromise<FUnHIDFeatureReportsResult>> FeatureReportsPromise;
+	};
+
+	struct FUnHIDCoalescedWrite
+	{
+		TArray<uint8> Data;
+		uint64 QueuedTimestamp = 0;
+		bool bPending = false;
+	};
+
+	// returns the request slot to fill (with the queue lock held) or nullptr if the queue is full
+	FUnHIDWriteRequest* AcquireRequest(const EUnHIDWriteType WriteType, const TArray<uint8>& Bytes, const int32 ReadSize);
+	void CompleteRequest(FUnHIDWriteRequest& Request, FUnHIDWriteResult& WriteResult);
+
+	// writer thread only: applies the write options
+	bool Write(const EUnHIDWriteType WriteType, const TArray<uint8>& Bytes, FString& ErrorMessage);
+	void Execute(FUnHIDWriteRequest& Request, FUnHIDWriteResult& WriteResult);
+	void UpdateStats(const bool bSuccess, const uint64 QueuedTimestamp, const uint64 CompletedTimestamp);
+
+	UUnHIDDevice* Device;
+	TWeakObjectPtr<UUnHIDDevice> WeakDevice;
+	class FUnHIDResponseMatcher* ResponseMatcher;
+
+	FRunnableThread* Thread = nullptr;
+	FEvent* WorkEvent = nullptr;
+	TAtomic<bool> bStopThread;
+
+	mutable FCriticalSection RequestsLock;
+	TArray<FUnHIDWriteRequest> Requests;
+	uint32 RequestsHead = 0;
+	uint32 RequestsTail = 0;
+
+	// indexed by report id
+	TArray<FUnHIDCoalescedWrite> CoalescedWrites;
+	int32 NumPendingCoalescedWrites = 0;
+	int32 NextCoalescedWrite = 0;
+
+	FUnHIDDeviceWriteOptions WriteOptions;
+
+	// writer thread only
+	TArray<uint8> CoalescedWriteBuffer;
+	TArray<TArray<uint8>> LastOutputReports;
+	uint64 NextOutputCycles = 0;
+
+	uint64 CompletedWrites = 0;
+	uint64 FailedWrites = 0;
+	double LastLatencyMilliseconds = 0;
+	double TotalLatencyMilliseconds = 0;
+	double MaxLatencyMilliseconds = 0;
+	uint64 SupersededWrites = 0;
+	uint64 SkippedWrites = 0;
+};
@@ -0,0 +1,217 @@
+// Copyright 2026 - Roberto De Ioris
+
+#include "UnHIDFeaturePollScheduler.h"
+#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "HAL/RunnableThread.h"
+
+namespace UnHID
+{
+	// devices can be destroyed by the garbage collector outside of the game thread
+	static FCriticalSection FeaturePollSchedulerLock;
+	static TUniquePtr<FUnHIDFeaturePollScheduler> FeaturePollScheduler;
+}
+
+FUnHIDFeaturePollScheduler& FUnHIDFeaturePollScheduler::Get()
+{
+	FScopeLock Lock(&UnHID::FeaturePollSchedulerLock);
+
+	if (!UnHID::FeaturePollScheduler)
+	{
+		UnHID::FeaturePollScheduler = TUniquePtr<FUnHIDFeaturePollScheduler>(new FUnHIDFeaturePollScheduler());
+	}
+
+	return *UnHID::FeaturePollScheduler;
+}
+
+FUnHIDFeaturePollScheduler* FUnHIDFeaturePollScheduler::GetPtr()
+{
+	FScopeLock Lock(&UnHID::FeaturePollSchedulerLock);
+
+	return UnHID::FeaturePollScheduler.Get();
+}
+
+void FUnHIDFeaturePollScheduler::Shutdown()
+{
+	FScopeLock Lock(&UnHID::FeaturePollSchedulerLock);
+
+	UnHID::FeaturePollScheduler.Reset();
+}
+
+FUnHIDFeaturePollScheduler::FUnHIDFeaturePollScheduler() : bStopThread(false)
+{
+	WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	InFlightCompletedEvent = FPlatformProcess::GetSynchEventFromPool(true);
+	InFlightCompletedEvent->Trigger();
+	Thread = FRunnableThread::Create(this, TEXT("UnHIDFeaturePollScheduler"));
+}
+
+FUnHIDFeaturePollScheduler::~FUnHIDFeaturePollScheduler()
+{
+	Stop();
+	if (Thread)
+	{
+		Thread->WaitForCompletion();
+		delete Thread;
+	}
+
+	Thread = nullptr;
+
+	FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+	WorkEvent = nullptr;
+
+	FPlatformProcess::ReturnSynchEventToPool(InFlightCompletedEvent);
+	InFlightCompletedEvent = nullptr;
+}
+
+int32 FUnHIDFeaturePollScheduler::Register(UUnHIDDevice* Device, const uint8 ReportId, const int32 Size, const float IntervalSeconds, const FUnHIDReadResultNativeDelegate& OnChanged)
+{
+	int32 PollHandle = 0;
+	{
+		FScopeLock Lock(&PollsLock);
+
+		FUnHIDFeaturePoll& Poll = Polls.AddDefaulted_GetRef();
+		Poll.PollHandle = NextPollHandle++;
+		Poll.Device = Device;
+		Poll.WeakDevice = Device;
+		Poll.ReportId = ReportId;
+		Poll.Size = Size;
+		Poll.IntervalCycles = static_cast<uint64>(FMath::Max(IntervalSeconds, 0.001f) / FPlatformTime::GetSecondsPerCycle64());
+		Poll.NextPollCycles = FPlatformTime::Cycles64();
+		Poll.OnChanged = OnChanged;
+
+		PollHandle = Poll.PollHandle;
+	}
+
+	WorkEvent->Trigger();
+
+	return PollHandle;
+}
+
+bool FUnHIDFeaturePollScheduler::Unregister(UUnHIDDevice* Device, const int32 PollHandle)
+{
+	FScopeLock Lock(&PollsLock);
+
+	return Polls.RemoveAll([Device, PollHandle](const FUnHIDFeaturePoll& Poll) { return Poll.Device == Device && Poll.PollHandle == PollHandle; }) > 0;
+}
+
+void FUnHIDFeaturePollScheduler::UnregisterDevice(UUnHIDDevice* Device)
+{
+	{
+		FScopeLock Lock(&PollsLock);
+
+		Polls.RemoveAll([Device](const FUnHIDFeaturePoll& Poll) { return Poll.Device == Device; });
+		if (InFlightDevice != Device)
+		{
+			return;
+		}
+	}
+
+	// the event has been reset (with PollsLock held) before the read started, so this waits for the current read
+	InFlightCompletedEvent->Wait();
+}
+
+uint32 FUnHIDFeaturePollScheduler::Run()
+{
+	TArray<uint8> Bytes;
+
+	while (!bStopThread)
+	{
+		int32 PollHandle = 0;
+		UUnHIDDevice* Device = nullptr;
+		uint8 ReportId = 0;
+		int32 Size = 0;
+
+		{
+			FScopeLock Lock(&PollsLock);
+
+			FUnHIDFeaturePoll* NextPoll = nullptr;
+			for (FUnHIDFeaturePoll& Poll : Polls)
+			{
+				if (!NextPoll || Poll.NextPollCycles < NextPoll->NextPollCycles)
+				{
+					NextPoll = &Poll;
+				}
+			}
+
+			if (!NextPoll)
+			{
+				Lock.Unlock();
+				WorkEvent->Wait();
+				continue;
+			}
+
+			const uint64 Now = FPlatformTime::Cycles64();
+			if (NextPoll->NextPollCycles > Now)
+			{
+				const uint32 WaitMilliseconds = FMath::Max<uint32>(1, static_cast<uint32>(FPlatformTime::ToMilliseconds64(NextPoll->NextPollCycles - Now)));
+				Lock.Unlock();
+				WorkEvent->Wait(WaitMilliseconds);
+				continue;
+			}
+
+			NextPoll->NextPollCycles = Now + NextPoll->IntervalCycles;
+			PollHandle = NextPoll->PollHandle;
+			Device = NextPoll->Device;
+			ReportId = NextPoll->ReportId;
+			Size = NextPoll->Size;
+
+			// published with PollsLock held, so UnregisterDevice() either sees it or the read has not started yet
+			InFlightDevice = Device;
+			InFlightCompletedEvent->Reset();
+		}
+
+		FUnHIDReadResult ReadResult;
+		ReadResult.QueuedTimestamp = static_cast<int64>(FPlatformTime::Cycles64());
+		ReadResult.StartedTimestamp = ReadResult.QueuedTimestamp;
+		ReadResult.bSuccess = Device->GetFeatureReportBytes(ReportId, Size, Bytes, ReadResult.ErrorMessage);
+		ReadResult.CompletedTimestamp = static_cast<int64>(FPlatformTime::Cycles64());
+
+		FScopeLock Lock(&PollsLock);
+
+		InFlightDevice = nullptr;
+		InFlightCompletedEvent->Trigger();
+
+		// the poll could have been unregistered in the meantime
+		FUnHIDFeaturePoll* Poll = Polls.FindByPredicate([PollHandle](const FUnHIDFeaturePoll& Poll) { return Poll.PollHandle == PollHandle; });
+		if (Poll && Poll->LastResult.Update(ReadResult.bSuccess, Bytes))
+		{
+			ReadResult.Bytes = Poll->LastResult.Bytes;
+			AsyncTask(ENamedThreads::GameThread, [WeakDevice = Poll->WeakDevice, OnChanged = Poll->OnChanged, ReadResult]()
+				{
+					if (WeakDevice.IsValid())
+					{
+						OnChanged.ExecuteIfBound(WeakDevice.Get(), ReadResult);
+					}
+				});
+		}
+	}
+
+	return 0;
+}
+
+bool FUnHIDFeaturePollResult::Update(const bool bNewSuccess, TArrayView<const uint8> NewBytes)
+{
+	// the payload of a failed read is meaningless, failures are compared only by success
+	const TArrayView<const uint8> NewPayload = bNewSuccess ? NewBytes : TArrayView<const uint8>();
+	if (bValid && bSuccess == bNewSuccess && Bytes.Num() == NewPayload.Num() && FMemory::Memcmp(Bytes.GetData(), NewPayload.GetData(), NewPayload.Num()) == 0)
+	{
+		return false;
+	}
+
+	bValid = true;
+	bSuccess = bNewSuccess;
+	Bytes.Reset();
+	Bytes.Append(NewPayload.GetData(), NewPayload.Num());
+	return true;
+}
+
+void FUnHIDFeaturePollScheduler::Stop()
+{
+	bStopThread = true;
+
+	if (WorkEvent)
+	{
+		WorkEvent->Trigger();
+	}
+}
@@ -0,0 +1,64 @@
+// Copyright 2026 - Roberto De Ioris
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "UnHIDDevice.h"
+
+/**
+ * Single background thread polling feature reports of all of the devices at their own intervals.
+ * Only the results different from the previous poll (payload or success) are delivered to the game thread.
+ */
+class FUnHIDFeaturePollScheduler : public FRunnable
+{
+public:
+	static FUnHIDFeaturePollScheduler& Get();
+	// does not start the scheduler
+	static FUnHIDFeaturePollScheduler* GetPtr();
+	static void Shutdown();
+
+	virtual ~FUnHIDFeaturePollScheduler();
+
+	// returns the poll handle (the first poll is immediate)
+	int32 Register(UUnHIDDevice* Device, const uint8 ReportId, const int32 Size, const float IntervalSeconds, const FUnHIDReadResultNativeDelegate& OnChanged);
+
+	// returns false if the poll handle does not belong to the device
+	bool Unregister(UUnHIDDevice* Device, const int32 PollHandle);
+
+	// when it returns the device is no more accessed by the scheduler thread
+	void UnregisterDevice(UUnHIDDevice* Device);
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	FUnHIDFeaturePollScheduler();
+
+	struct FUnHIDFeaturePoll
+	{
+		int32 PollHandle = 0;
+		UUnHIDDevice* Device = nullptr;
+		TWeakObjectPtr<UUnHIDDevice> WeakDevice;
+		uint8 ReportId = 0;
+		int32 Size = 0;
+		uint64 IntervalCycles = 0;
+		uint64 NextPollCycles = 0;
+		FUnHIDReadResultNativeDelegate OnChanged;
+		FUnHIDFeaturePollResult LastResult;
+	};
+
+	FRunnableThread* Thread = nullptr;
+	FEvent* WorkEvent = nullptr;
+	TAtomic<bool> bStopThread;
+
+	FCriticalSection PollsLock;
+	TArray<FUnHIDFeaturePoll> Polls;
+	int32 NextPollHandle = 1;
+
+	// the device being read by the scheduler thread (protected by PollsLock)
+	UUnHIDDevice* InFlightDevice = nullptr;
+	// manual reset, triggered when the read of InFlightDevice completes
+	FEvent* InFlightCompletedEvent = nullptr;
+};
@@ -0,0 +1,241 @@
+// Copyright 2026 - Roberto De Ioris
+
+#include "UnHIDReportDecoder.h"
+#include "UnHIDBitfield.h"
+#include "UnHIDUsageIndex.h"
+
+FUnHIDReportDecoder::FUnHIDReportDecoder(const FUnHIDDeviceDescriptorReports& DescriptorReports)
+{
+	bHasReportIds = DescriptorReports.Inputs.Num() > 1 || (DescriptorReports.Inputs.Num() == 1 && DescriptorReports.Inputs[0].ReportId != 0);
+
+	LayoutsByReportId.Init(INDEX_NONE, 256);
+
+	for (const FUnHIDDeviceDescriptorReport& Report : DescriptorReports.Inputs)
+	{
+		if (Report.ReportId < 0 || Report.ReportId > 255 || LayoutsByReportId[Report.ReportId] != INDEX_NONE)
+		{
+			continue;
+		}
+
+		LayoutsByReportId[Report.ReportId] = Layouts.Num();
+		FUnHIDDecoderLayout& Layout = Layouts.AddDefaulted_GetRef();
+		Layout.ReportId = Report.ReportId;
+
+		for (const FUnHIDDeviceDescriptorReportItem& Item : Report.Items)
+		{
+			if (Item.BitSize <= 0 || Item.BitSize > 64)
+			{
+				continue;
+			}
+
+			// padding (constant items without usages)
+			if (Item.Usage.Num() == 0 && Item.UsageMinimum == 0 && Item.UsageMaximum == 0)
+			{
+				continue;
+			}
+
+			// explicit usages first, then the usage range (as in UnHIDGetDescriptorReportItemFromDescriptorReportsAndUsage)
+			const int64 NumRangeUsages = Item.UsageMaximum >= Item.UsageMinimum ? Item.UsageMaximum - Item.UsageMinimum + 1 : 0;
+			const int64 NumFields = FMath::Min<int64>(Item.Count, Item.Usage.Num() + NumRangeUsages);
+			for (int64 FieldIndex = 0; FieldIndex < NumFields; FieldIndex++)
+			{
+				FUnHIDDecoderField Field;
+				Field.UsagePage = Item.UsagePage;
+				Field.Usage = FieldIndex < Item.Usage.Num() ? Item.Usage[FieldIndex] : Item.UsageMinimum + (FieldIndex - Item.Usage.Num());
+				Field.BitOffset = (bHasReportIds ? 8 : 0) + Item.BitOffset + Item.BitSize * FieldIndex;
+				Field.BitSize = Item.BitSize;
+				Field.LogicalMinimum = Item.LogicalMinimum;
+				Field.LogicalMaximum = Item.LogicalMaximum;
+				Field.bSigned = Item.LogicalMinimum < 0 || Item.LogicalMaximum < 0;
+				Field.bButton = Item.BitSize == 1;
+				Field.Index = Field.bButton ? Layout.NumButtons++ : Layout.NumValues++;
+
+				if (!Field.bButton)
+				{
+					Layout.ValueBitOffsets.Add(Field.BitOffset);
+					Layout.ValueBitSizes.Add(static_cast<int32>(Field.BitSize));
+				}
+
+				// the first field declaring a usage wins
+				const uint64 UsageKey = UnHID::GetUsageKey(Field.UsagePage, Field.Usage);
+				if (!Layout.FieldsByUsage.Contains(UsageKey))
+				{
+					Layout.FieldsByUsage.Add(UsageKey, Layout.Fields.Num());
+				}
+
+				Layout.Fields.Add(Field);
+			}
+		}
+
+		int64 NumBits = 0;
+		for (const FUnHIDDecoderField& Field : Layout.Fields)
+		{
+			NumBits = FMath::Max(NumBits, Field.BitOffset + Field.BitSize);
+		}
+
+		Layout.FirstFieldByWord.SetNumUninitialized(static_cast<int32>((NumBits + 63) / 64));
+		int32 FirstField = 0;
+		for (int32 WordIndex = 0; WordIndex < Layout.FirstFieldByWord.Num(); WordIndex++)
+		{
+			while (FirstField < Layout.Fields.Num() && Layout.Fields[FirstField].BitOffset + Layout.Fields[FirstField].BitSize <= WordIndex * 64)
+			{
+				FirstField++;
+			}
+			Layout.FirstFieldByWord[WordIndex] = FirstField;
+		}
+	}
+}
+
+const FUnHIDReportDecoder::FUnHIDDecoderLayout* FUnHIDReportDecoder::FindReportLayout(TArrayView<const uint8> Bytes) const
+{
+	if (Bytes.Num() < 1)
+	{
+		return nullptr;
+	}
+
+	return FindLayout(bHasReportIds ? Bytes[0] : 0);
+}
+
+const FUnHIDReportDecoder::FUnHIDDecoderLayout* FUnHIDReportDecoder::FindLayout(const int32 ReportId) const
+{
+	if (!LayoutsByReportId.IsValidIndex(ReportId) || LayoutsByReportId[ReportId] == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	return &Layouts[LayoutsByReportId[ReportId]];
+}
+
+bool FUnHIDReportDecoder::Decode(TArrayView<const uint8> Bytes, FUnHIDDecodedReport& DecodedReport) const
+{
+	const FUnHIDDecoderLayout* Layout = FindReportLayout(Bytes);
+	if (!Layout)
+	{
+		return false;
+	}
+
+	// no allocations when the same buffer is used for the same report
+	DecodedReport.ReportId = Layout->ReportId;
+	DecodedReport.Values.Reset();
+	DecodedReport.Values.AddUninitialized(Layout->NumValues);
+	DecodedReport.NormalizedValues.Reset();
+	DecodedReport.NormalizedValues.AddUninitialized(Layout->NumValues);
+	DecodedReport.Buttons.Init(Layout->NumButtons);
+
+	// all of the values in a single batch, then sign extension and normalization
+	UnHID::ExtractBitsBatch(Bytes, Layout->ValueBitOffsets, Layout->ValueBitSizes, TArrayView<uint64>(reinterpret_cast<uint64*>(DecodedReport.Values.GetData()), Layout->NumValues));
+
+	for (const FUnHIDDecoderField& Field : Layout->Fields)
+	{
+		if (Field.bButton)
+		{
+			DecodedReport.Buttons.Words[Field.Index / 64] |= static_cast<int64>(UnHID::ExtractBits(Bytes, Field.BitOffset, 1) << (Field.Index % 64));
+			continue;
+		}
+
+		DecodeValue(Field, static_cast<uint64>(DecodedReport.Values[Field.Index]), DecodedReport.Values[Field.Index], DecodedReport.NormalizedValues[Field.Index]);
+	}
+
+	return true;
+}
+
+bool FUnHIDReportDecoder::FindChangedUsages(TArrayView<const uint8> PreviousReport, TArrayView<const uint8> Report, TArray<FUnHIDChangedUsage>& ChangedUsages) const
+{
+	ChangedUsages.Reset();
+
+	const FUnHIDDecoderLayout* Layout = FindReportLayout(Report);
+	if (!Layout)
+	{
+		return false;
+	}
+
+	// a field spanning two changed words is checked only once
+	int32 NextField = 0;
+	for (int32 WordIndex = 0; WordIndex < Layout->FirstFieldByWord.Num(); WordIndex++)
+	{
+		const int64 WordBitOffset = static_cast<int64>(WordIndex) * 64;
+		// the same 64 bits in both of the reports, most of the words of a report
+		if ((UnHID::ExtractBits(Report, WordBitOffset, 64) ^ UnHID::ExtractBits(PreviousReport, WordBitOffset, 64)) == 0)
+		{
+			continue;
+		}
+
+		for (int32 FieldIndex = FMath::Max(NextField, Layout->FirstFieldByWord[WordIndex]); FieldIndex < Layout->Fields.Num() && Layout->Fields[FieldIndex].BitOffset < WordBitOffset + 64; FieldIndex++)
+		{
+			NextField = FieldIndex + 1;
+
+			const FUnHIDDecoderField& Field = Layout->Fields[FieldIndex];
+			const uint64 Bits = UnHID::ExtractBits(Report, Field.BitOffset, Field.BitSize);
+			const uint64 PreviousBits = UnHID::ExtractBits(PreviousReport, Field.BitOffset, Field.BitSize);
+			if (Bits == PreviousBits)
+			{
+				continue;
+			}
+
+			FUnHIDChangedUsage& ChangedUsage = ChangedUsages.AddDefaulted_GetRef();
+			ChangedUsage.ReportId = Layout->ReportId;
+			ChangedUsage.UsagePage = static_cast<int32>(Field.UsagePage);
+			ChangedUsage.Usage = static_cast<int32>(Field.Usage);
+			if (Field.bButton)
+			{
+				ChangedUsage.Value = static_cast<int64>(Bits);
+				ChangedUsage.PreviousValue = static_cast<int64>(PreviousBits);
+				ChangedUsage.NormalizedValue = static_cast<float>(Bits);
+				continue;
+			}
+
+			float PreviousNormalizedValue = 0;
+			DecodeValue(Field, Bits, ChangedUsage.Value, ChangedUsage.NormalizedValue);
+			DecodeValue(Field, PreviousBits, ChangedUsage.PreviousValue, PreviousNormalizedValue);
+		}
+	}
+
+	return true;
+}
+
+void FUnHIDReportDecoder::DecodeValue(const FUnHIDDecoderField& Field, const uint64 Bits, int64& Value, float& NormalizedValue)
+{
+	Value = static_cast<int64>(Bits);
+	if (Field.bSigned && Field.BitSize < 64 && (Bits & (1ULL << (Field.BitSize - 1))))
+	{
+		Value = static_cast<int64>(Bits | ~((1ULL << Field.BitSize) - 1));
+	}
+
+	NormalizedValue = FMath::GetMappedRangeValueClamped(TRange<double>(Field.LogicalMinimum, Field.LogicalMaximum), TRange<double>(-1, 1), static_cast<double>(Value));
+}
+
+bool FUnHIDReportDecoder::GetUsage(const FUnHIDDecodedReport& DecodedReport, const int32 UsagePage, const int32 Usage, int64& Value, float& NormalizedValue) const
+{
+	const FUnHIDDecoderLayout* Layout = FindLayout(DecodedReport.ReportId);
+	if (!Layout)
+	{
+		return false;
+	}
+
+	const int32* FieldIndex = Layout->FieldsByUsage.Find(UnHID::GetUsageKey(UsagePage, Usage));
+	if (!FieldIndex)
+	{
+		return false;
+	}
+
+	const FUnHIDDecoderField& Field = Layout->Fields[*FieldIndex];
+	if (Field.bButton)
+	{
+		if (Field.Index >= DecodedReport.Buttons.NumBits)
+		{
+			return false;
+		}
+		Value = DecodedReport.Buttons.IsSet(Field.Index) ? 1 : 0;
+		NormalizedValue = static_cast<float>(Value);
+		return true;
+	}
+
+	if (!DecodedReport.Values.IsValidIndex(Field.Index) || !DecodedReport.NormalizedValues.IsValidIndex(Field.Index))
+	{
+		return false;
+	}
+
+	Value = DecodedReport.Values[Field.Index];
+	NormalizedValue = DecodedReport.NormalizedValues[Field.Index];
+	return true;
+}
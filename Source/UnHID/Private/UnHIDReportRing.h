@@ -0,0 +1,125 @@
+// Copyright 2026 - Roberto De Ioris
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Bounded single-producer/single-consumer ring of fixed size report slots.
+ * The producer (the device reader) writes directly into the next free slot,
+ * the consumer (the game thread) drains it once per frame.
+ * Committed slots can be published one at a time or in bursts (a single release store for the whole burst).
+ * All of the memory is allocated on construction.
+ */
+class FUnHIDReportRing
+{
+public:
+	FUnHIDReportRing(const int32 InNumSlots, const int32 InSlotSize)
+	{
+		NumSlots = FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(InNumSlots, 2)));
+		SlotSize = FMath::Max(InSlotSize, 1);
+
+		Slots.AddZeroed(static_cast<int64>(NumSlots) * SlotSize);
+		SlotsSize.AddZeroed(NumSlots);
+		SlotsTimestamp.AddZeroed(NumSlots);
+	}
+
+	// Producer side: returns the memory of the next free slot (or nullptr if the ring is full)
+	uint8* GetWriteSlot()
+	{
+		if (WriteHead - Tail.load(std::memory_order_acquire) >= NumSlots)
+		{
+			return nullptr;
+		}
+
+		return Slots.GetData() + static_cast<int64>(WriteHead & (NumSlots - 1)) * SlotSize;
+	}
+
+	// Producer side: commits the slot returned by GetWriteSlot(), the consumer will see it after the next Publish()
+	void CommitWriteSlot(const int32 Size, const uint64 Timestamp, const bool bPublish = true)
+	{
+		SlotsSize[WriteHead & (NumSlots - 1)] = FMath::Clamp(Size, 0, SlotSize);
+		SlotsTimestamp[WriteHead & (NumSlots - 1)] = Timestamp;
+		WriteHead++;
+		if (bPublish)
+		{
+			Publish();
+		}
+	}
+
+	// Producer side: makes all of the committed slots visible to the consumer
+	void Publish()
+	{
+		Head.store(WriteHead, std::memory_order_release);
+	}
+
+	// Producer side: committed (even if not yet published) slots
+	int32 NumCommitted() const
+	{
+		return static_cast<int32>(WriteHead - Tail.load(std::memory_order_acquire));
+	}
+
+	// Consumer side: returns the oldest published slot without removing it
+	bool Peek(const uint8*& Data, int32& Size, uint64& Timestamp) const
+	{
+		const uint32 CurrentTail = Tail.load(std::memory_order_relaxed);
+		if (CurrentTail == Head.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		const uint32 SlotIndex = CurrentTail & (NumSlots - 1);
+		Data = Slots.GetData() + static_cast<int64>(SlotIndex) * SlotSize;
+		Size = SlotsSize[SlotIndex];
+		Timestamp = SlotsTimestamp[SlotIndex];
+		return true;
+	}
+
+	// Consumer side: releases the slot returned by Peek()
+	void Pop()
+	{
+		Tail.store(Tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	// Consumer side: releases the oldest Count published slots without reading them
+	void Discard(const int32 Count)
+	{
+		const uint32 CurrentTail = Tail.load(std::memory_order_relaxed);
+		const uint32 Available = Head.load(std::memory_order_acquire) - CurrentTail;
+		Tail.store(CurrentTail + FMath::Min(static_cast<uint32>(FMath::Max(Count, 0)), Available), std::memory_order_release);
+	}
+
+	int32 Num() const
+	{
+		return static_cast<int32>(Head.load(std::memory_order_acquire) - Tail.load(std::memory_order_acquire));
+	}
+
+	int32 GetNumSlots() const
+	{
+		return NumSlots;
+	}
+
+	int32 GetSlotSize() const
+	{
+		return SlotSize;
+	}
+
+	int64 GetBufferSize() const
+	{
+		return Slots.GetAllocatedSize() + SlotsSize.GetAllocatedSize() + SlotsTimestamp.GetAllocatedSize();
+	}
+
+private:
+	uint32 NumSlots = 0;
+	int32 SlotSize = 0;
+
+	TArray64<uint8> Slots;
+	TArray<int32> SlotsSize;
+	TArray<uint64> SlotsTimestamp;
+
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Head{ 0 };
+	// owned by the producer
+	uint32 WriteHead = 0;
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Tail{ 0 };
+};
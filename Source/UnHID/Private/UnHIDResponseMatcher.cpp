@@ -0,0 +1,192 @@
+// Copyright 2026 - Roberto De Ioris
+
+#include "UnHIDResponseMatcher.h"
+#include "Async/Async.h"
+
+FUnHIDResponseMatcher::FUnHIDResponseMatcher(UUnHIDDevice* InDevice) : NumPendingResponses(0)
+{
+	WeakDevice = InDevice;
+}
+
+FUnHIDResponseMatcher::~FUnHIDResponseMatcher()
+{
+	TArray<FUnHIDPendingResponse> TerminatedResponses;
+	{
+		FScopeLock Lock(&PendingResponsesLock);
+		TerminatedResponses = MoveTemp(PendingResponses);
+		PendingResponses.Reset();
+		NumPendingResponses = 0;
+	}
+
+	// nobody is waiting forever for a response that will never arrive
+	for (FUnHIDPendingResponse& PendingResponse : TerminatedResponses)
+	{
+		FUnHIDReadResult ReadResult;
+		ReadResult.ErrorMessage = "Device terminated";
+		Complete(PendingResponse, ReadResult);
+	}
+}
+
+uint64 FUnHIDResponseMatcher::Add(const FUnHIDResponsePredicate& ResponsePredicate, const uint64 QueuedTimestamp, const float TimeoutSeconds, const FUnHIDReadResultNativeDelegate& OnResponseReceived, TOptional<TPromise<FUnHIDReadResult>>&& Promise)
+{
+	FScopeLock Lock(&PendingResponsesLock);
+
+	FUnHIDPendingResponse& PendingResponse = PendingResponses.AddDefaulted_GetRef();
+	PendingResponse.PendingResponseId = NextPendingResponseId++;
+	PendingResponse.ResponsePredicate = MakeShared<FUnHIDResponsePredicate, ESPMode::ThreadSafe>(ResponsePredicate);
+	PendingResponse.QueuedTimestamp = QueuedTimestamp;
+	PendingResponse.StartedTimestamp = FPlatformTime::Cycles64();
+	PendingResponse.DeadlineCycles = PendingResponse.StartedTimestamp + static_cast<uint64>(FMath::Max(TimeoutSeconds, 0.0f) / FPlatformTime::GetSecondsPerCycle64());
+	PendingResponse.OnResponseReceived = OnResponseReceived;
+	PendingResponse.Promise = MoveTemp(Promise);
+
+	NumPendingResponses++;
+
+	return PendingResponse.PendingResponseId;
+}
+
+void FUnHIDResponseMatcher::Fail(const uint64 PendingResponseId, const FString& ErrorMessage)
+{
+	FUnHIDPendingResponse FailedResponse;
+	if (!RemovePendingResponse(PendingResponseId, FailedResponse))
+	{
+		return;
+	}
+
+	FUnHIDReadResult ReadResult;
+	ReadResult.ErrorMessage = ErrorMessage;
+	Complete(FailedResponse, ReadResult);
+}
+
+uint32 FUnHIDResponseMatcher::ExpirePendingResponses()
+{
+	if (NumPendingResponses == 0)
+	{
+		return MAX_uint32;
+	}
+
+	const uint64 Now = FPlatformTime::Cycles64();
+	uint64 NextDeadlineCycles = MAX_uint64;
+	{
+		FScopeLock Lock(&PendingResponsesLock);
+
+		for (int32 Index = PendingResponses.Num() - 1; Index >= 0; Index--)
+		{
+			FUnHIDPendingResponse& PendingResponse = PendingResponses[Index];
+			if (PendingResponse.DeadlineCycles <= Now)
+			{
+				ExpiredResponses.Add(MoveTemp(PendingResponse));
+				PendingResponses.RemoveAt(Index);
+				NumPendingResponses--;
+			}
+			else
+			{
+				NextDeadlineCycles = FMath::Min(NextDeadlineCycles, PendingResponse.DeadlineCycles);
+			}
+		}
+	}
+
+	// completed without the lock, the continuations can add (or fail) requests
+	for (FUnHIDPendingResponse& ExpiredResponse : ExpiredResponses)
+	{
+		FUnHIDReadResult ReadResult;
+		ReadResult.ErrorMessage = "Response timeout";
+		Complete(ExpiredResponse, ReadResult);
+	}
+	ExpiredResponses.Reset();
+
+	if (NextDeadlineCycles == MAX_uint64)
+	{
+		return MAX_uint32;
+	}
+
+	return FMath::Max<uint32>(1, static_cast<uint32>(FPlatformTime::ToMilliseconds64(NextDeadlineCycles - Now)));
+}
+
+bool FUnHIDResponseMatcher::MatchReport(const uint8* Data, const int32 Size, const uint64 Timestamp)
+{
+	// snapshot of the pending requests (oldest first), the predicates are executed without the lock
+	{
+		FScopeLock Lock(&PendingResponsesLock);
+
+		Candidates.Reset();
+		for (const FUnHIDPendingResponse& PendingResponse : PendingResponses)
+		{
+			Candidates.Add({ PendingResponse.PendingResponseId, PendingResponse.ResponsePredicate });
+		}
+	}
+
+	bool bMatched = false;
+	const TArrayView<const uint8> Report(Data, Size);
+	for (const FUnHIDResponseCandidate& Candidate : Candidates)
+	{
+		if (!Candidate.ResponsePredicate->IsBound() || !Candidate.ResponsePredicate->Execute(Report))
+		{
+			continue;
+		}
+
+		// expired (or failed) while the predicates were running
+		FUnHIDPendingResponse MatchedResponse;
+		if (!RemovePendingResponse(Candidate.PendingResponseId, MatchedResponse))
+		{
+			continue;
+		}
+
+		FUnHIDReadResult ReadResult;
+		ReadResult.bSuccess = true;
+		ReadResult.Bytes.Append(Data, Size);
+		ReadResult.CompletedTimestamp = static_cast<int64>(Timestamp);
+		Complete(MatchedResponse, ReadResult);
+
+		// a report completes a single request
+		bMatched = true;
+		break;
+	}
+
+	// releases the predicates of the completed requests
+	Candidates.Reset();
+
+	return bMatched;
+}
+
+bool FUnHIDResponseMatcher::RemovePendingResponse(const uint64 PendingResponseId, FUnHIDPendingResponse& RemovedResponse)
+{
+	FScopeLock Lock(&PendingResponsesLock);
+
+	const int32 Index = PendingResponses.IndexOfByPredicate([PendingResponseId](const FUnHIDPendingResponse& PendingResponse) { return PendingResponse.PendingResponseId == PendingResponseId; });
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	RemovedResponse = MoveTemp(PendingResponses[Index]);
+	PendingResponses.RemoveAt(Index);
+	NumPendingResponses--;
+	return true;
+}
+
+void FUnHIDResponseMatcher::Complete(FUnHIDPendingResponse& PendingResponse, FUnHIDReadResult& ReadResult)
+{
+	ReadResult.QueuedTimestamp = static_cast<int64>(PendingResponse.QueuedTimestamp);
+	ReadResult.StartedTimestamp = static_cast<int64>(PendingResponse.StartedTimestamp);
+	if (ReadResult.CompletedTimestamp == 0)
+	{
+		ReadResult.CompletedTimestamp = static_cast<int64>(FPlatformTime::Cycles64());
+	}
+
+	if (PendingResponse.Promise.IsSet())
+	{
+		PendingResponse.Promise->SetValue(ReadResult);
+	}
+
+	if (PendingResponse.OnResponseReceived.IsBound())
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakDevice = WeakDevice, OnResponseReceived = PendingResponse.OnResponseReceived, ReadResult]()
+			{
+				if (WeakDevice.IsValid())
+				{
+					OnResponseReceived.ExecuteIfBound(WeakDevice.Get(), ReadResult);
+				}
+			});
+	}
+}
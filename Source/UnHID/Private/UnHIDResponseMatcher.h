@@ -0,0 +1,75 @@
+// Copyright 2026 - Roberto De Ioris
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnHIDDevice.h"
+
+/**
+ * Requests (output reports) waiting for their response (an input report).
+ * Requests are added just before being written, input reports are matched by the reader thread
+ * against the pending requests (oldest first), so multiple requests can be in flight at the same time.
+ * The predicates are evaluated without holding the lock, so they never stall the writer (and can be slow),
+ * a request expired (or failed) in the meantime is simply skipped.
+ */
+class FUnHIDResponseMatcher
+{
+public:
+	FUnHIDResponseMatcher(UUnHIDDevice* InDevice);
+	// pending requests are completed with an error
+	~FUnHIDResponseMatcher();
+
+	// before writing the request (writer or bulk transfer thread): returns the id of the pending request
+	uint64 Add(const FUnHIDResponsePredicate& ResponsePredicate, const uint64 QueuedTimestamp, const float TimeoutSeconds, const FUnHIDReadResultNativeDelegate& OnResponseReceived, TOptional<TPromise<FUnHIDReadResult>>&& Promise);
+
+	// the request could not be written (or the caller gave up waiting)
+	void Fail(const uint64 PendingResponseId, const FString& ErrorMessage);
+
+	// writer thread only: returns the milliseconds to the next timeout (MAX_uint32 if nothing is pending)
+	uint32 ExpirePendingResponses();
+
+	// reader thread only: returns true if the report completed a request
+	bool MatchReport(const uint8* Data, const int32 Size, const uint64 Timestamp);
+
+	bool HasPendingResponses() const
+	{
+		return NumPendingResponses > 0;
+	}
+
+private:
+	struct FUnHIDPendingResponse
+	{
+		uint64 PendingResponseId = 0;
+		// shared with the reader thread candidates
+		TSharedPtr<FUnHIDResponsePredicate, ESPMode::ThreadSafe> ResponsePredicate;
+		uint64 QueuedTimestamp = 0;
+		uint64 StartedTimestamp = 0;
+		uint64 DeadlineCycles = 0;
+		FUnHIDReadResultNativeDelegate OnResponseReceived;
+		TOptional<TPromise<FUnHIDReadResult>> Promise;
+	};
+
+	struct FUnHIDResponseCandidate
+	{
+		uint64 PendingResponseId;
+		TSharedPtr<FUnHIDResponsePredicate, ESPMode::ThreadSafe> ResponsePredicate;
+	};
+
+	// moves the request out of the pending ones, returns false if it has already been completed
+	bool RemovePendingResponse(const uint64 PendingResponseId, FUnHIDPendingResponse& RemovedResponse);
+	// never called with the lock held: the promise continuations can call back into the matcher
+	void Complete(FUnHIDPendingResponse& PendingResponse, FUnHIDReadResult& ReadResult);
+
+	TWeakObjectPtr<UUnHIDDevice> WeakDevice;
+
+	FCriticalSection PendingResponsesLock;
+	// oldest first
+	TArray<FUnHIDPendingResponse> PendingResponses;
+	uint64 NextPendingResponseId = 1;
+	TAtomic<int32> NumPendingResponses;
+
+	// reader thread only (reused to avoid allocations)
+	TArray<FUnHIDResponseCandidate> Candidates;
+	// writer thread only (reused to avoid allocations)
+	TArray<FUnHIDPendingResponse> ExpiredResponses;
+};
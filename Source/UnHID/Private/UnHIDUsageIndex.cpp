@@ -0,0 +1,106 @@
+// Copyright 2026 - Roberto De Ioris
+
+#include "UnHIDUsageIndex.h"
+
+namespace UnHID
+{
+	// keyboard and button pages stay well below it
+	constexpr int64 MaxExpandedUsageRange = 1024;
+}
+
+FUnHIDUsageIndex::FUnHIDUsageIndex(const FUnHIDDeviceDescriptorReports& DescriptorReports)
+{
+	Inputs.Build(DescriptorReports.Inputs);
+	Features.Build(DescriptorReports.Features);
+}
+
+void FUnHIDUsageIndex::FUnHIDUsageTable::Build(const TArray<FUnHIDDeviceDescriptorReport>& Reports)
+{
+	const bool bHasReportIdPrefix = Reports.Num() > 1 || (Reports.Num() == 1 && Reports[0].ReportId != 0);
+	int32 ItemOrdinal = 0;
+	for (const FUnHIDDeviceDescriptorReport& Report : Reports)
+	{
+		for (const FUnHIDDeviceDescriptorReportItem& Item : Report.Items)
+		{
+			FUnHIDIndexedUsage IndexedUsage;
+			IndexedUsage.ItemOrdinal = ItemOrdinal++;
+			FUnHIDUsageLocation& UsageLocation = IndexedUsage.UsageLocation;
+			UsageLocation.ReportId = Report.ReportId;
+			UsageLocation.BitSize = Item.BitSize;
+			UsageLocation.LogicalMinimum = Item.LogicalMinimum;
+			UsageLocation.LogicalMaximum = Item.LogicalMaximum;
+
+			const int64 ItemBitOffset = (bHasReportIdPrefix ? 8 : 0) + Item.BitOffset;
+
+			// the first item declaring a usage wins (as in the linear scan)
+			for (int32 UsageIndex = 0; UsageIndex < Item.Usage.Num(); UsageIndex++)
+			{
+				const uint64 UsageKey = UnHID::GetUsageKey(Item.UsagePage, Item.Usage[UsageIndex]);
+				if (!Usages.Contains(UsageKey))
+				{
+					UsageLocation.BitOffset = ItemBitOffset + Item.BitSize * UsageIndex;
+					Usages.Add(UsageKey, IndexedUsage);
+				}
+			}
+
+			if (Item.UsageMaximum < Item.UsageMinimum)
+			{
+				continue;
+			}
+
+			// range usages follow the explicit ones
+			const int64 RangeBitOffset = ItemBitOffset + Item.BitSize * Item.Usage.Num();
+			if (Item.UsageMaximum - Item.UsageMinimum >= UnHID::MaxExpandedUsageRange)
+			{
+				FUnHIDUsageRange& UsageRange = UsageRanges.AddDefaulted_GetRef();
+				UsageRange.UsagePage = Item.UsagePage;
+				UsageRange.UsageMinimum = Item.UsageMinimum;
+				UsageRange.UsageMaximum = Item.UsageMaximum;
+				UsageRange.IndexedUsage = IndexedUsage;
+				UsageRange.IndexedUsage.UsageLocation.BitOffset = RangeBitOffset;
+				continue;
+			}
+
+			for (int64 Usage = Item.UsageMinimum; Usage <= Item.UsageMaximum; Usage++)
+			{
+				const uint64 UsageKey = UnHID::GetUsageKey(Item.UsagePage, Usage);
+				if (!Usages.Contains(UsageKey))
+				{
+					UsageLocation.BitOffset = RangeBitOffset + Item.BitSize * (Usage - Item.UsageMinimum);
+					Usages.Add(UsageKey, IndexedUsage);
+				}
+			}
+		}
+	}
+
+	Usages.Compact();
+}
+
+bool FUnHIDUsageIndex::FUnHIDUsageTable::Find(const int32 UsagePage, const int32 Usage, FUnHIDUsageLocation& UsageLocation) const
+{
+	const FUnHIDIndexedUsage* FoundIndexedUsage = Usages.Find(UnHID::GetUsageKey(UsagePage, Usage));
+
+	// a range declared by an earlier item wins over the indexed usage (ranges are sorted by item)
+	for (const FUnHIDUsageRange& UsageRange : UsageRanges)
+	{
+		if (FoundIndexedUsage && UsageRange.IndexedUsage.ItemOrdinal >= FoundIndexedUsage->ItemOrdinal)
+		{
+			break;
+		}
+
+		if (UsageRange.UsagePage == UsagePage && Usage >= UsageRange.UsageMinimum && Usage <= UsageRange.UsageMaximum)
+		{
+			UsageLocation = UsageRange.IndexedUsage.UsageLocation;
+			UsageLocation.BitOffset += UsageLocation.BitSize * (Usage - UsageRange.UsageMinimum);
+			return true;
+		}
+	}
+
+	if (FoundIndexedUsage)
+	{
+		UsageLocation = FoundIndexedUsage->UsageLocation;
+		return true;
+	}
+
+	return false;
+}
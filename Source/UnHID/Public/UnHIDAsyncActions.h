@@ -0,0 +1,70 @@
+// Copyright 2026 - Roberto De Ioris
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "UnHIDDevice.h"
+#include "UnHIDAsyncActions.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FUnHIDGetFeatureReportAsyncActionDelegate, const FUnHIDReadResult&, ReadResult, const FString&, ErrorMessage);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FUnHIDSetFeatureReportAsyncActionDelegate, const FUnHIDWriteResult&, WriteResult, const FString&, ErrorMessage);
+
+/**
+ * Feature report get executed by the device writer thread, the game thread never blocks.
+ */
+UCLASS()
+class UNHID_API UUnHIDGetFeatureReportAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", DisplayName = "UnHIDDevice Get Feature Report Bytes (Async)"), Category = "UnHID")
+	static UUnHIDGetFeatureReportAsyncAction* UnHIDGetFeatureReportBytesAsyncAction(UObject* WorldContextObject, UUnHIDDevice* UnHIDDevice, const uint8 ReportId, const int32 Size);
+
+	UPROPERTY(BlueprintAssignable)
+	FUnHIDGetFeatureReportAsyncActionDelegate OnSuccess;
+
+	UPROPERTY(BlueprintAssignable)
+	FUnHIDGetFeatureReportAsyncActionDelegate OnFailure;
+
+	virtual void Activate() override;
+
+protected:
+	void OnCompleted(UUnHIDDevice* InUnHIDDevice, const FUnHIDReadResult& ReadResult);
+
+	UPROPERTY()
+	UUnHIDDevice* UnHIDDevice = nullptr;
+
+	uint8 ReportId = 0;
+	int32 Size = 0;
+};
+
+/**
+ * Feature report set executed by the device writer thread, the game thread never blocks.
+ */
+UCLASS()
+class UNHID_API UUnHIDSetFeatureReportAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", DisplayName = "UnHIDDevice Set Feature Report Bytes (Async)"), Category = "UnHID")
+	static UUnHIDSetFeatureReportAsyncAction* UnHIDSetFeatureReportBytesAsyncAction(UObject* WorldContextObject, UUnHIDDevice* UnHIDDevice, const TArray<uint8>& Bytes);
+
+	UPROPERTY(BlueprintAssignable)
+	FUnHIDSetFeatureReportAsyncActionDelegate OnSuccess;
+
+	UPROPERTY(BlueprintAssignable)
+	FUnHIDSetFeatureReportAsyncActionDelegate OnFailure;
+
+	virtual void Activate() override;
+
+protected:
+	void OnCompleted(UUnHIDDevice* InUnHIDDevice, const FUnHIDWriteResult& WriteResult);
+
+	UPROPERTY()
+	UUnHIDDevice* UnHIDDevice = nullptr;
+
+	TArray<uint8> Bytes;
+};
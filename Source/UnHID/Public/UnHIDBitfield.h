@@ -0,0 +1,24 @@
+// Copyright 2026 - Roberto De Ioris
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Bit field extraction kernels (HID reports are little endian, fields are not aligned to bytes).
+ * Bits after the end of Bytes are always read as 0.
+ */
+namespace UnHID
+{
+	// BitSize from 1 to 64 (0 is returned for invalid offsets/sizes)
+	UNHID_API uint64 ExtractBits(TArrayView<const uint8> Bytes, const int64 BitOffset, const int64 BitSize);
+
+	// Values[Index] = ExtractBits(Bytes, BitOffsets[Index], BitSizes[Index]) using AVX2/NEON when available
+	UNHID_API void ExtractBitsBatch(TArrayView<const uint8> Bytes, TArrayView<const int64> BitOffsets, TArrayView<const int32> BitSizes, TArrayView<uint64> Values);
+
+	// one bool per bit, truncated at the end of Bytes
+	UNHID_API void ExtractBitmask(TArrayView<const uint8> Bytes, const int64 BitOffset, const int64 BitSize, TArray<bool>& Bitmask);
+
+	// the batch kernel compiled in ("AVX2", "NEON" or "Scalar")
+	UNHID_API const TCHAR* GetExtractBitsBatchKernelName();
+}
@@ -9,6 +9,8 @@
 
 
 DECLARE_DYNAMIC_DELEGATE_ThreeParams(FUnHIDReadDynamicDelegate, UUnHIDDevice*, UnHIDDevice, const TArray<uint8>&, Data, const FString&, ErrorMessage);
+DECLARE_DYNAMIC_DELEGATE_FourParams(FUnHIDReadWithTimestampDynamicDelegate, UUnHIDDevice*, UnHIDDevice, const TArray<uint8>&, Data, const int64, Timestamp, const FString&, ErrorMessage);
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FUnHIDReadBatchDynamicDelegate, UUnHIDDevice*, UnHIDDevice, const FUnHIDReportBatch&, ReportBatch, const FString&, ErrorMessage);
 
 UENUM()
 enum class EUnHIDReportDescriptorGlobalItems : uint8
@@ -125,8 +127,53 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHID Open Multiple Devices by Usage filter with HexStrings"), Category = "UnHID")
 	static TArray<UUnHIDDevice*> UnHIDOpenDevicesByUsageFilterHexStrings(const FString& UsagePageHexString, const FString& UsageHexString, const FUnHIDReadDynamicDelegate& InUnHIDReadDynamicDelegate, TArray<FString>& ErrorMessages);
 
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHID Open Device with ReadOptions"), Category = "UnHID")
+	static UUnHIDDevice* UnHIDOpenDeviceWithReadOptions(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& ReadOptions, const FUnHIDReadDynamicDelegate& InUnHIDReadDynamicDelegate, FString& ErrorMessage);
+
+	// the delegate gets the timestamp of every report too (see UnHID Timestamp to Seconds)
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHID Open Device with Timestamp"), Category = "UnHID")
+	static UUnHIDDevice* UnHIDOpenDeviceWithTimestamp(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadWithTimestampDynamicDelegate& InUnHIDReadWithTimestampDynamicDelegate, FString& ErrorMessage);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHID Open Device with ReadOptions with Timestamp"), Category = "UnHID")
+	static UUnHIDDevice* UnHIDOpenDeviceWithReadOptionsWithTimestamp(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& ReadOptions, const FUnHIDReadWithTimestampDynamicDelegate& InUnHIDReadWithTimestampDynamicDelegate, FString& ErrorMessage);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHID Open Device Batched"), Category = "UnHID")
+	static UUnHIDDevice* UnHIDOpenDeviceBatched(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadBatchDynamicDelegate& InUnHIDReadBatchDynamicDelegate, FString& ErrorMessage);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHID Open Device Batched with ReadOptions"), Category = "UnHID")
+	static UUnHIDDevice* UnHIDOpenDeviceBatchedWithReadOptions(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& ReadOptions, const FUnHIDReadBatchDynamicDelegate& InUnHIDReadBatchDynamicDelegate, FString& ErrorMessage);
+
 	static UUnHIDDevice* UnHIDOpenDevice(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadNativeDelegate& InUnHIDReadNativeDelegate, FString& ErrorMessage);
 
+	static UUnHIDDevice* UnHIDOpenDeviceWithReadOptions(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& ReadOptions, const FUnHIDReadNativeDelegate& InUnHIDReadNativeDelegate, FString& ErrorMessage);
+
+	static UUnHIDDevice* UnHIDOpenDeviceWithTimestamp(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadWithTimestampNativeDelegate& InUnHIDReadWithTimestampNativeDelegate, FString& ErrorMessage);
+
+	static UUnHIDDevice* UnHIDOpenDeviceWithReadOptionsWithTimestamp(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& ReadOptions, const FUnHIDReadWithTimestampNativeDelegate& InUnHIDReadWithTimestampNativeDelegate, FString& ErrorMessage);
+
+	static UUnHIDDevice* UnHIDOpenDeviceBatched(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadBatchNativeDelegate& InUnHIDReadBatchNativeDelegate, FString& ErrorMessage);
+
+	static UUnHIDDevice* UnHIDOpenDeviceBatchedWithReadOptions(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& ReadOptions, const FUnHIDReadBatchNativeDelegate& InUnHIDReadBatchNativeDelegate, FString& ErrorMessage);
+
+	// the delegate is invoked on the reader thread, see UUnHIDDevice::Initialize for the threading rules
+	static UUnHIDDevice* UnHIDOpenDeviceAnyThread(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadAnyThreadNativeDelegate& InUnHIDReadAnyThreadNativeDelegate, FString& ErrorMessage);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHID Get Report from Report Batch"), Category = "UnHID")
+	static TArray<uint8> UnHIDGetReportFromReportBatch(const FUnHIDReportBatch& ReportBatch, const int32 Index);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHID Get Timestamp Now"), Category = "UnHID")
+	static int64 UnHIDGetTimestampNow();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHID Timestamp to Seconds"), Category = "UnHID")
+	static double UnHIDTimestampToSeconds(const int64 Timestamp);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHID Timestamps Delta to Milliseconds"), Category = "UnHID")
+	static double UnHIDTimestampsDeltaToMilliseconds(const int64 FromTimestamp, const int64 ToTimestamp);
+
+	// bits set in Mask (missing bytes of Mask are 0xFF) must be equal in Bytes and Pattern
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHID Match Bytes with Mask"), Category = "UnHID")
+	static bool UnHIDMatchBytesWithMask(const TArray<uint8>& Bytes, const TArray<uint8>& Pattern, const TArray<uint8>& Mask);
+
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHID Get Reports from Report Descriptor Bytes"), Category = "UnHID")
 	static FUnHIDDeviceDescriptorReports UnHIDGetReportsFromReportDescriptorBytes(const TArray<uint8>& UnHIDReportDescriptorBytes, FString& ErrorMessage);
 
@@ -142,6 +189,27 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHID Parse Bitmask from Bytes"), Category = "UnHID")
 	static TArray<bool> UnHIDParseBitmaskFromBytes(const TArray<uint8>& Bytes, const int64 BitOffset, const int64 BitSize);
 
+	// packed version of UnHIDParseBitmaskFromBytes (always BitSize bits, the ones after the end of Bytes are 0)
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHID Parse Bitset from Bytes"), Category = "UnHID")
+	static FUnHIDBitset UnHIDParseBitsetFromBytes(const TArray<uint8>& Bytes, const int64 BitOffset, const int32 BitSize);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHID Bitset Is Set"), Category = "UnHID")
+	static bool UnHIDBitsetIsSet(const FUnHIDBitset& Bitset, const int32 Index);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHID Bitset Count Set Bits"), Category = "UnHID")
+	static int32 UnHIDBitsetCountSetBits(const FUnHIDBitset& Bitset);
+
+	// indices of the bits set, in ascending order
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHID Bitset Get Set Bits"), Category = "UnHID")
+	static TArray<int32> UnHIDBitsetGetSetBits(const FUnHIDBitset& Bitset);
+
+	// the changed bits when Previous is the previous state
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHID Bitset Xor"), Category = "UnHID")
+	static FUnHIDBitset UnHIDBitsetXor(const FUnHIDBitset& Bitset, const FUnHIDBitset& Previous);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHID Bitset to Bitmask"), Category = "UnHID")
+	static TArray<bool> UnHIDBitsetToBitmask(const FUnHIDBitset& Bitset);
+
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHID Parse Unsigned Integer from Bytes"), Category = "UnHID")
 	static int64 UnHIDParseUnsignedIntegerFromBytes(const TArray<uint8>& Bytes, const int64 BitOffset, const int64 BitSize);
 
@@ -0,0 +1,54 @@
+// Copyright 2026 - Roberto De Ioris
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnHIDDevice.h"
+
+/**
+ * Frames, windows and retries of a bulk transfer, independent from the device (every frame goes through the SendFrame function).
+ * Send() is called by a single thread, the stats can be read by any thread.
+ */
+class UNHID_API FUnHIDBulkTransferFrames
+{
+public:
+	// Frame is the report id followed by the payload, bAwaitAck is set for the last frame of an acknowledged window
+	// (the function returns only after the acknowledgement), returns false on error (ErrorMessage is set)
+	using FSendFrameFunction = TFunctionRef<bool(const TArray<uint8>& Frame, const bool bAwaitAck, FString& ErrorMessage)>;
+
+	// InFrameSize is the payload of each frame (the report id is prefixed)
+	FUnHIDBulkTransferFrames(const TArray<uint8>& InData, const FUnHIDBulkTransferOptions& InBulkTransferOptions, const int32 InFrameSize);
+
+	int32 GetNumFrames() const
+	{
+		return NumFrames;
+	}
+
+	// the last frame is zero padded
+	void BuildFrame(const int32 FrameIndex, TArray<uint8>& Frame) const;
+
+	// sends every window (retrying the failed ones), returns false on error or when bCancelled is set (ErrorMessage is set)
+	bool Send(FSendFrameFunction SendFrame, const TAtomic<bool>& bCancelled, FString& ErrorMessage);
+
+	void UpdateProgress(const int32 SentFrames);
+
+	// the final stats
+	void Complete(const bool bSuccess, const FString& ErrorMessage, FUnHIDBulkTransferStats& CompletedStats);
+
+	void GetStats(FUnHIDBulkTransferStats& BulkTransferStats) const;
+
+private:
+	bool SendWindow(FSendFrameFunction SendFrame, const TAtomic<bool>& bCancelled, const int32 FirstFrame, const int32 NumWindowFrames, FString& ErrorMessage);
+
+	TArray<uint8> Data;
+	FUnHIDBulkTransferOptions BulkTransferOptions;
+	int32 FrameSize;
+	int32 NumFrames;
+
+	// sending thread only
+	TArray<uint8> FrameBuffer;
+	uint64 StartCycles = 0;
+
+	mutable FCriticalSection StatsLock;
+	FUnHIDBulkTransferStats Stats;
+};
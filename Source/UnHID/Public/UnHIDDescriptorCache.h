@@ -0,0 +1,83 @@
+// Copyright 2026 - Roberto De Ioris
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnHIDDevice.h"
+#include "Async/Future.h"
+
+/**
+ * Report descriptors and their parsed reports, persisted in Saved/UnHID/DescriptorCache.bin.
+ * Entries are keyed by the device identity (vendor, product, release, interface and top level usage)
+ * plus a hash of the report descriptor bytes, so a device is parsed only the first time it is seen.
+ * All of the functions can be called by any thread, the file is loaded and written by background tasks
+ * (the cache is empty until the load has completed).
+ */
+class UNHID_API FUnHIDDescriptorCache
+{
+public:
+	struct FUnHIDDescriptorCacheEntry
+	{
+		int32 VendorId = 0;
+		int32 ProductId = 0;
+		int32 ReleaseNumber = 0;
+		int32 InterfaceNumber = 0;
+		int32 UsagePage = 0;
+		int32 Usage = 0;
+		uint64 ReportDescriptorHash = 0;
+		TArray<uint8> ReportDescriptor;
+		TSharedPtr<const FUnHIDDeviceDescriptorReports> DescriptorReports;
+	};
+
+	static FUnHIDDescriptorCache& Get();
+	static void Shutdown();
+
+	// pending saves are completed
+	~FUnHIDDescriptorCache();
+
+	// by identity only (no need to open the device), a firmware update without a new release number is detected at the next open
+	bool FindReportDescriptor(const FUnHIDDeviceInfo& DeviceInfo, TArray<uint8>& ReportDescriptor, TSharedPtr<const FUnHIDDeviceDescriptorReports>& DescriptorReports);
+
+	// by identity and report descriptor hash
+	TSharedPtr<const FUnHIDDeviceDescriptorReports> FindDescriptorReports(const FUnHIDDeviceInfo& DeviceInfo, TArrayView<const uint8> ReportDescriptor);
+
+	// returns the cached reports or parses (and caches) the report descriptor
+	TSharedPtr<const FUnHIDDeviceDescriptorReports> GetOrParseDescriptorReports(const FUnHIDDeviceInfo& DeviceInfo, const TArray<uint8>& ReportDescriptor, FString& ErrorMessage);
+
+	// removes every entry (and the file)
+	void Clear();
+
+	static FUnHIDDescriptorCacheEntry MakeEntry(const FUnHIDDeviceInfo& DeviceInfo, const TArray<uint8>& ReportDescriptor, const TSharedPtr<const FUnHIDDeviceDescriptorReports>& DescriptorReports);
+
+	// the file format (checksummed), returns false (and no entries) for corrupted, truncated or old data
+	static void SaveEntriesToBytes(const TArray<FUnHIDDescriptorCacheEntry>& EntriesToSave, TArray<uint8>& Bytes);
+	static bool LoadEntriesFromBytes(const TArray<uint8>& Bytes, TArray<FUnHIDDescriptorCacheEntry>& LoadedEntries);
+
+private:
+	FUnHIDDescriptorCache();
+
+	FUnHIDDescriptorCacheEntry* FindEntry(const FUnHIDDeviceInfo& DeviceInfo);
+	// background task
+	void Load();
+	// with EntriesLock held, delayed until the file has been loaded
+	void ScheduleSave();
+	// background task, a snapshot older than the last saved one (or than a Clear()) is discarded
+	void Save(const TArray<FUnHIDDescriptorCacheEntry>& EntriesToSave, const uint64 Generation);
+	static bool SerializeEntries(FArchive& Archive, TArray<FUnHIDDescriptorCacheEntry>& EntriesToSerialize);
+
+	FString Filename;
+	FCriticalSection EntriesLock;
+	// a few devices, a linear scan is enough
+	TArray<FUnHIDDescriptorCacheEntry> Entries;
+	// protected by EntriesLock
+	uint64 SaveGeneration = 0;
+	TArray<TFuture<void>> PendingSaves;
+	bool bLoaded = false;
+	bool bSaveAfterLoad = false;
+	bool bClearedWhileLoading = false;
+
+	TFuture<void> LoadTask;
+
+	FCriticalSection SaveLock;
+	uint64 SavedGeneration = 0;
+};
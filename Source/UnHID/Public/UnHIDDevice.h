@@ -4,9 +4,15 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "Tickable.h"
+#include "Async/Future.h"
 #include "UnHIDDevice.generated.h"
 
 DECLARE_DELEGATE_ThreeParams(FUnHIDReadNativeDelegate, UUnHIDDevice*, const TArray<uint8>&, const FString&);
+// the timestamp is the FPlatformTime::Cycles64() value captured right after the report has been read
+DECLARE_DELEGATE_FourParams(FUnHIDReadWithTimestampNativeDelegate, UUnHIDDevice*, const TArray<uint8>&, const int64, const FString&);
+// invoked on the reader thread, the report memory is valid only for the duration of the call
+DECLARE_DELEGATE_FourParams(FUnHIDReadAnyThreadNativeDelegate, UUnHIDDevice*, TArrayView<const uint8>, const int64, const FString&);
 
 UENUM()
 enum class EUnHIDBusType : uint8
@@ -19,6 +25,17 @@ enum class EUnHIDBusType : uint8
 	Virtual
 };
 
+UENUM()
+enum class EUnHIDReadQueuePolicy : uint8
+{
+	// when the queue is full the new reports are discarded
+	DropNewest,
+	// when the queue is full the oldest queued report is discarded
+	DropOldest,
+	// keep only the newest report for each report id
+	Coalesce
+};
+
 USTRUCT(BlueprintType)
 struct FUnHIDDeviceInfo
 {
@@ -63,8 +80,22 @@ namespace UnHID
 {
 	EUnHIDBusType ToUnHIDBusType(const int32 BusType);
 	void FillDeviceInfo(const hid_device_info*, FUnHIDDeviceInfo& UnHIDDeviceInfo);
+	// bits set in Mask (missing bytes of Mask are 0xFF) must be equal in Bytes and Pattern
+	UNHID_API bool MatchBytesWithMask(TArrayView<const uint8> Bytes, TArrayView<const uint8> Pattern, TArrayView<const uint8> Mask);
 }
 
+// last result of a polled feature report (see StartFeatureReportPolling)
+struct UNHID_API FUnHIDFeaturePollResult
+{
+	bool bValid = false;
+	bool bSuccess = false;
+	// empty for failures
+	TArray<uint8> Bytes;
+
+	// stores the new result, returns true if it is the first one or it is different (success or payload) from the previous one
+	bool Update(const bool bNewSuccess, TArrayView<const uint8> NewBytes);
+};
+
 USTRUCT(BlueprintType)
 struct FUnHIDDeviceDescriptorReportItem
 {
@@ -149,17 +180,489 @@ struct FUnHIDDeviceDescriptorReports
 	TArray<FUnHIDDeviceDescriptorReport> Features;
 };
 
+// packed bits (buttons), 64 for each element of Words
+USTRUCT(BlueprintType)
+struct FUnHIDBitset
+{
+	GENERATED_BODY()
+
+	// the bits after NumBits are always 0
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	TArray<int64> Words;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int32 NumBits = 0;
+
+	// all of the bits to 0 (no allocations when the size does not grow)
+	void Init(const int32 InNumBits)
+	{
+		NumBits = FMath::Max(InNumBits, 0);
+		Words.Reset();
+		Words.AddZeroed((NumBits + 63) / 64);
+	}
+
+	// BitSize bits from Bytes (the ones after the end of Bytes are 0)
+	UNHID_API void SetFromBytes(TArrayView<const uint8> Bytes, const int64 BitOffset, const int32 BitSize);
+
+	bool IsSet(const int32 Index) const
+	{
+		return Index >= 0 && Index < NumBits && Words.IsValidIndex(Index / 64) && ((static_cast<uint64>(Words[Index / 64]) >> (Index % 64)) & 1);
+	}
+
+	void Set(const int32 Index, const bool bValue)
+	{
+		if (Index < 0 || Index >= NumBits || !Words.IsValidIndex(Index / 64))
+		{
+			return;
+		}
+
+		const uint64 Bit = 1ULL << (Index % 64);
+		Words[Index / 64] = static_cast<int64>(bValue ? static_cast<uint64>(Words[Index / 64]) | Bit : static_cast<uint64>(Words[Index / 64]) & ~Bit);
+	}
+
+	int32 CountSetBits() const
+	{
+		int32 NumSetBits = 0;
+		for (const int64 Word : Words)
+		{
+			NumSetBits += static_cast<int32>(FMath::CountBits(static_cast<uint64>(Word)));
+		}
+		return NumSetBits;
+	}
+
+	bool IsZero() const
+	{
+		for (const int64 Word : Words)
+		{
+			if (Word != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Callable(int32 Index) for every bit set, in ascending order
+	template<typename CallableType>
+	void ForEachSetBit(CallableType&& Callable) const
+	{
+		for (int32 WordIndex = 0; WordIndex < Words.Num(); WordIndex++)
+		{
+			uint64 Word = static_cast<uint64>(Words[WordIndex]);
+			while (Word)
+			{
+				Callable(WordIndex * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Word)));
+				// clear the lowest bit set
+				Word &= Word - 1;
+			}
+		}
+	}
+
+	// the bits that are different in Other (the changed buttons when Other is the previous state)
+	void Xor(const FUnHIDBitset& Other, FUnHIDBitset& Result) const
+	{
+		Result.Init(FMath::Max(NumBits, Other.NumBits));
+		for (int32 WordIndex = 0; WordIndex < Result.Words.Num(); WordIndex++)
+		{
+			const int64 Word = Words.IsValidIndex(WordIndex) ? Words[WordIndex] : 0;
+			const int64 OtherWord = Other.Words.IsValidIndex(WordIndex) ? Other.Words[WordIndex] : 0;
+			Result.Words[WordIndex] = Word ^ OtherWord;
+		}
+	}
+
+	bool operator==(const FUnHIDBitset& Other) const
+	{
+		return NumBits == Other.NumBits && Words == Other.Words;
+	}
+
+	bool operator!=(const FUnHIDBitset& Other) const
+	{
+		return !(*this == Other);
+	}
+};
+
+// every field of an input report, filled by FUnHIDReportDecoder (the arrays are reused between reports)
+USTRUCT(BlueprintType)
+struct FUnHIDDecodedReport
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int32 ReportId = 0;
+
+	// non single bit fields, in descriptor order
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	TArray<int64> Values;
+
+	// Values mapped from the logical range to -1/1
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	TArray<float> NormalizedValues;
+
+	// single bit fields, in descriptor order
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	FUnHIDBitset Buttons;
+};
+
+// a field of an input report different from the previous report with the same id
+USTRUCT(BlueprintType)
+struct FUnHIDChangedUsage
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int32 ReportId = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int32 UsagePage = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int32 Usage = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 Value = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 PreviousValue = 0;
+
+	// Value mapped from the logical range to -1/1 (0/1 for buttons)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	float NormalizedValue = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FUnHIDReportBatch
+{
+	GENERATED_BODY()
+
+	// all of the reports of the batch, one after the other
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	TArray<uint8> Data;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	TArray<int32> Offsets;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	TArray<int32> Sizes;
+
+	// FPlatformTime::Cycles64() when the report has been read
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	TArray<int64> Timestamps;
+
+	// reports discarded (by the queue policy) since the previous batch
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int32 DroppedCount = 0;
+
+	int32 Num() const
+	{
+		return Sizes.Num();
+	}
+
+	TArrayView<const uint8> GetReport(const int32 Index) const
+	{
+		return TArrayView<const uint8>(Data.GetData() + Offsets[Index], Sizes[Index]);
+	}
+
+	void Add(const uint8* ReportData, const int32 ReportSize, const uint64 Timestamp)
+	{
+		Offsets.Add(Data.Num());
+		Sizes.Add(ReportSize);
+		Timestamps.Add(static_cast<int64>(Timestamp));
+		Data.Append(ReportData, ReportSize);
+	}
+
+	// keeps the allocations
+	void Reset()
+	{
+		Data.Reset();
+		Offsets.Reset();
+		Sizes.Reset();
+		Timestamps.Reset();
+		DroppedCount = 0;
+	}
+};
+
+USTRUCT(BlueprintType)
+struct FUnHIDDeviceReadOptions
+{
+	GENERATED_BODY()
+
+	// what to do with the reports when the game thread does not keep up with the device
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	EUnHIDReadQueuePolicy QueuePolicy = EUnHIDReadQueuePolicy::DropNewest;
+
+	// maximum number of reports waiting for the game thread (<= 0 for the default), ignored by the Coalesce policy
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int32 MaxQueuedReports = 0;
+
+	// after each wakeup keep reading (without blocking) until the device queue is empty, the burst is published as a single batch
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	bool bDrainOnWakeup = false;
+
+	// reports byte-identical to the previous one with the same report id are discarded by the reader thread (they still complete the requests waiting for a response)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	bool bSkipIdenticalReports = false;
+};
+
+USTRUCT(BlueprintType)
+struct FUnHIDDeviceReadStats
+{
+	GENERATED_BODY()
+
+	// reports read from the device and queued (or passed to the any-thread delegate)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 EnqueuedReports = 0;
+
+	// reports passed to the read delegates
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 DeliveredReports = 0;
+
+	// reports discarded by the queue policy
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 DroppedReports = 0;
+
+	// identical reports discarded by bSkipIdenticalReports (not counted in EnqueuedReports)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 SuppressedReports = 0;
+
+	// reports currently waiting for the game thread
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int32 QueuedReports = 0;
+};
+
+DECLARE_DELEGATE_ThreeParams(FUnHIDReadBatchNativeDelegate, UUnHIDDevice*, const FUnHIDReportBatch&, const FString&);
+
+USTRUCT(BlueprintType)
+struct FUnHIDWriteResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	bool bSuccess = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	FString ErrorMessage;
+
+	// FPlatformTime::Cycles64() when the write has been queued, started (by the writer thread) and completed
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 QueuedTimestamp = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 StartedTimestamp = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 CompletedTimestamp = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FUnHIDReadResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	bool bSuccess = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	FString ErrorMessage;
+
+	// FPlatformTime::Cycles64() when the read has been queued, started and completed
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 QueuedTimestamp = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 StartedTimestamp = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 CompletedTimestamp = 0;
+
+	// the received report (report id included)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	TArray<uint8> Bytes;
+};
+
+USTRUCT(BlueprintType)
+struct FUnHIDDeviceWriteStats
+{
+	GENERATED_BODY()
+
+	// writes waiting for (or being processed by) the writer thread
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int32 QueuedWrites = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 CompletedWrites = 0;
+
+	// failed writes (including the ones rejected because the queue was full)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 FailedWrites = 0;
+
+	// from queueing to completion
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	double LastLatencyMilliseconds = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	double AverageLatencyMilliseconds = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	double MaxLatencyMilliseconds = 0;
+
+	// coalesced writes replaced by a newer payload before being sent
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 SupersededWrites = 0;
+
+	// output reports not sent because identical to the last one sent with the same report id
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 SkippedWrites = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FUnHIDDeviceWriteOptions
+{
+	GENERATED_BODY()
+
+	// maximum number of output reports per second sent by the writer thread (<= 0 for no limit)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	float MaxWritesPerSecond = 0;
+
+	// do not send an output report identical to the last one sent with the same report id
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	bool bSkipIdenticalWrites = false;
+};
+
+USTRUCT(BlueprintType)
+struct FUnHIDFeatureReportsResult
+{
+	GENERATED_BODY()
+
+	// true if all of the feature reports have been received
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	bool bSuccess = false;
+
+	// one for each requested report id (in the same order), with its own timing
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	TArray<FUnHIDReadResult> Reports;
+};
+
+USTRUCT(BlueprintType)
+struct FUnHIDBulkTransferOptions
+{
+	GENERATED_BODY()
+
+	// every frame is sent with this report id, the frame size is taken from the descriptor
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	uint8 ReportId = 0;
+
+	// send feature reports instead of output reports
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	bool bFeatureReports = false;
+
+	// number of frames after which an acknowledgement (input report) is awaited (<= 0 for no acknowledgements)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int32 WindowSize = 0;
+
+	// the acknowledgement must match AckPattern/AckMask (see UnHID Match Bytes with Mask)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	TArray<uint8> AckPattern;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	TArray<uint8> AckMask;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	float AckTimeoutSeconds = 1;
+
+	// a failed frame (or a not acknowledged window) is sent again up to MaxRetries times
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int32 MaxRetries = 3;
+};
+
+USTRUCT(BlueprintType)
+struct FUnHIDBulkTransferStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	bool bCompleted = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	bool bSuccess = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	FString ErrorMessage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 TotalBytes = 0;
+
+	// payload bytes sent (and acknowledged, when using windows)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 SentBytes = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int64 SentFrames = 0;
+
+	// 0 to 1
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	float Progress = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	double BytesPerSecond = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UnHID")
+	int32 Retries = 0;
+};
+
+// completion of the asynchronous writes, always invoked on the game thread
+DECLARE_DELEGATE_TwoParams(FUnHIDWriteNativeDelegate, UUnHIDDevice*, const FUnHIDWriteResult&);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FUnHIDWriteDynamicDelegate, UUnHIDDevice*, UnHIDDevice, const FUnHIDWriteResult&, WriteResult);
+// completion of the asynchronous reads, always invoked on the game thread
+DECLARE_DELEGATE_TwoParams(FUnHIDReadResultNativeDelegate, UUnHIDDevice*, const FUnHIDReadResult&);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FUnHIDReadResultDynamicDelegate, UUnHIDDevice*, UnHIDDevice, const FUnHIDReadResult&, ReadResult);
+DECLARE_DELEGATE_TwoParams(FUnHIDFeatureReportsNativeDelegate, UUnHIDDevice*, const FUnHIDFeatureReportsResult&);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FUnHIDFeatureReportsDynamicDelegate, UUnHIDDevice*, UnHIDDevice, const FUnHIDFeatureReportsResult&, FeatureReportsResult);
+DECLARE_DELEGATE_TwoParams(FUnHIDBulkTransferNativeDelegate, UUnHIDDevice*, const FUnHIDBulkTransferStats&);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FUnHIDBulkTransferDynamicDelegate, UUnHIDDevice*, UnHIDDevice, const FUnHIDBulkTransferStats&, BulkTransferStats);
+// called on the reader thread for every input report while a request is waiting for its response (without locks held, but keep it short: the following reports wait for it)
+DECLARE_DELEGATE_RetVal_OneParam(bool, FUnHIDResponsePredicate, TArrayView<const uint8>);
+DECLARE_DELEGATE_TwoParams(FUnHIDUsagesChangedNativeDelegate, UUnHIDDevice*, const TArray<FUnHIDChangedUsage>&);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FUnHIDUsagesChangedDynamicDelegate, UUnHIDDevice*, UnHIDDevice, const TArray<FUnHIDChangedUsage>&, ChangedUsages);
+DECLARE_DELEGATE_TwoParams(FUnHIDUsageChangedNativeDelegate, UUnHIDDevice*, const FUnHIDChangedUsage&);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FUnHIDUsageChangedDynamicDelegate, UUnHIDDevice*, UnHIDDevice, const FUnHIDChangedUsage&, ChangedUsage);
+
 /**
  *
  */
 UCLASS(BlueprintType)
-class UNHID_API UUnHIDDevice : public UObject
+class UNHID_API UUnHIDDevice : public UObject, public FTickableGameObject
 {
 	GENERATED_BODY()
 
 public:
 	~UUnHIDDevice();
+
+	// FTickableGameObject interface (reports received by the worker thread are dispatched here)
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableInEditor() const override { return true; }
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual TStatId GetStatId() const override;
+
 	bool Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadNativeDelegate& InReadNativeDelegate, FString& ErrorMessage);
+	bool Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadBatchNativeDelegate& InReadBatchNativeDelegate, FString& ErrorMessage);
+	bool Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& InReadOptions, const FUnHIDReadNativeDelegate& InReadNativeDelegate, FString& ErrorMessage);
+	bool Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& InReadOptions, const FUnHIDReadBatchNativeDelegate& InReadBatchNativeDelegate, FString& ErrorMessage);
+	bool Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadWithTimestampNativeDelegate& InReadWithTimestampNativeDelegate, FString& ErrorMessage);
+	bool Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& InReadOptions, const FUnHIDReadWithTimestampNativeDelegate& InReadWithTimestampNativeDelegate, FString& ErrorMessage);
+
+	/**
+	 * Reports (and the read error) are delivered synchronously on the reader thread, without waiting for the next game thread tick.
+	 * Threading rules for the delegate:
+	 * - it runs on a worker thread (on Linux a single thread serves all of the devices), keep it short and never block on the game thread
+	 * - do not touch UObjects (other than the device itself) or anything else owned by the game thread
+	 * - WriteBytes, WriteHexString and the feature report functions are thread safe and can be called from it
+	 * - never call Terminate or StopWorkerThread from it (they wait for the delegate to return)
+	 * - the queue policy is ignored
+	 */
+	bool Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDReadAnyThreadNativeDelegate& InReadAnyThreadNativeDelegate, FString& ErrorMessage);
+	bool Initialize(const FUnHIDDeviceInfo& UnHIDDeviceInfo, const FUnHIDDeviceReadOptions& InReadOptions, const FUnHIDReadAnyThreadNativeDelegate& InReadAnyThreadNativeDelegate, FString& ErrorMessage);
 	void StopWorkerThread();
 	void Terminate();
 
@@ -169,6 +672,85 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Write HexString"), Category = "UnHID")
 	bool WriteHexString(const FString& HexString, FString& ErrorMessage);
 
+	// asynchronous writes are queued (without blocking) and executed by the device writer thread
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Write Bytes Async"), Category = "UnHID")
+	bool WriteBytesAsync(const TArray<uint8>& Bytes, const FUnHIDWriteDynamicDelegate& OnWriteCompleted, FString& ErrorMessage);
+
+	bool WriteBytesAsync(const TArray<uint8>& Bytes, const FUnHIDWriteNativeDelegate& OnWriteCompleted, FString& ErrorMessage);
+
+	// the future is set on the writer thread
+	TFuture<FUnHIDWriteResult> WriteBytesAsync(const TArray<uint8>& Bytes);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Set Feature Report Bytes Async"), Category = "UnHID")
+	bool SetFeatureReportBytesAsync(const TArray<uint8>& Bytes, const FUnHIDWriteDynamicDelegate& OnWriteCompleted, FString& ErrorMessage);
+
+	bool SetFeatureReportBytesAsync(const TArray<uint8>& Bytes, const FUnHIDWriteNativeDelegate& OnWriteCompleted, FString& ErrorMessage);
+
+	TFuture<FUnHIDWriteResult> SetFeatureReportBytesAsync(const TArray<uint8>& Bytes);
+
+	// executed by the writer thread too (in order with the writes), the report is returned in FUnHIDReadResult::Bytes
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Get Feature Report Bytes Async"), Category = "UnHID")
+	bool GetFeatureReportBytesAsync(const uint8 ReportId, const int32 Size, const FUnHIDReadResultDynamicDelegate& OnReportReceived, FString& ErrorMessage);
+
+	bool GetFeatureReportBytesAsync(const uint8 ReportId, const int32 Size, const FUnHIDReadResultNativeDelegate& OnReportReceived, FString& ErrorMessage);
+
+	TFuture<FUnHIDReadResult> GetFeatureReportBytesAsync(const uint8 ReportId, const int32 Size);
+
+	// the sizes are taken from the descriptor feature reports, the reports are read back to back by the writer thread
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Get Feature Reports Bytes Async"), Category = "UnHID")
+	bool GetFeatureReportsBytesAsync(const TArray<uint8>& ReportIds, const FUnHIDFeatureReportsDynamicDelegate& OnReportsReceived, FString& ErrorMessage);
+
+	bool GetFeatureReportsBytesAsync(const TArray<uint8>& ReportIds, const FUnHIDFeatureReportsNativeDelegate& OnReportsReceived, FString& ErrorMessage);
+
+	TFuture<FUnHIDFeatureReportsResult> GetFeatureReportsBytesAsync(const TArray<uint8>& ReportIds);
+
+	// the output report is written by the writer thread and the request is completed by the first input report matching ResponsePattern/ResponseMask
+	// (returned in FUnHIDReadResult::Bytes), multiple requests can be in flight (the oldest matching one is completed first)
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Send Request Bytes"), Category = "UnHID")
+	bool SendRequestBytes(const TArray<uint8>& Bytes, const TArray<uint8>& ResponsePattern, const TArray<uint8>& ResponseMask, const float TimeoutSeconds, const FUnHIDReadResultDynamicDelegate& OnResponseReceived, FString& ErrorMessage);
+
+	bool SendRequestBytes(const TArray<uint8>& Bytes, const FUnHIDResponsePredicate& ResponsePredicate, const float TimeoutSeconds, const FUnHIDReadResultNativeDelegate& OnResponseReceived, FString& ErrorMessage);
+
+	// the future is set on the reader thread (or on the writer thread for errors and timeouts)
+	TFuture<FUnHIDReadResult> SendRequestBytes(const TArray<uint8>& Bytes, const FUnHIDResponsePredicate& ResponsePredicate, const float TimeoutSeconds);
+
+	TFuture<FUnHIDReadResult> SendRequestBytes(const TArray<uint8>& Bytes, const TArray<uint8>& ResponsePattern, const TArray<uint8>& ResponseMask, const float TimeoutSeconds);
+
+	// Data is split in frames (sized from the descriptor report) sent by a background thread, a single transfer at a time
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Start Bulk Transfer"), Category = "UnHID")
+	bool StartBulkTransfer(const TArray<uint8>& Data, const FUnHIDBulkTransferOptions& BulkTransferOptions, const FUnHIDBulkTransferDynamicDelegate& OnBulkTransferCompleted, FString& ErrorMessage);
+
+	bool StartBulkTransfer(const TArray<uint8>& Data, const FUnHIDBulkTransferOptions& BulkTransferOptions, const FUnHIDBulkTransferNativeDelegate& OnBulkTransferCompleted, FString& ErrorMessage);
+
+	// the running transfer fails with "Cancelled"
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Cancel Bulk Transfer"), Category = "UnHID")
+	void CancelBulkTransfer();
+
+	// progress of the running (or last) transfer
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHIDDevice Get Bulk Transfer Stats"), Category = "UnHID")
+	FUnHIDBulkTransferStats GetBulkTransferStats() const;
+
+	// the feature report is polled every IntervalSeconds by the shared scheduler thread, only changes are notified (on the game thread)
+	// a Size <= 0 is taken from the descriptor feature reports
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Start Feature Report Polling"), Category = "UnHID")
+	bool StartFeatureReportPolling(const uint8 ReportId, const int32 Size, const float IntervalSeconds, const FUnHIDReadResultDynamicDelegate& OnReportChanged, int32& PollHandle, FString& ErrorMessage);
+
+	bool StartFeatureReportPolling(const uint8 ReportId, const int32 Size, const float IntervalSeconds, const FUnHIDReadResultNativeDelegate& OnReportChanged, int32& PollHandle, FString& ErrorMessage);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Stop Feature Report Polling"), Category = "UnHID")
+	bool StopFeatureReportPolling(const int32 PollHandle);
+
+	// only the newest payload for each report id (the first byte) is sent, without completion notification
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Write Bytes Coalesced"), Category = "UnHID")
+	bool WriteBytesCoalesced(const TArray<uint8>& Bytes, FString& ErrorMessage);
+
+	// rate limit and deduplication of the output reports sent by the writer thread
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Set Write Options"), Category = "UnHID")
+	void SetWriteOptions(const FUnHIDDeviceWriteOptions& InWriteOptions);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHIDDevice Get Write Stats"), Category = "UnHID")
+	FUnHIDDeviceWriteStats GetWriteStats() const;
+
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Get Feature Report Bytes"), Category = "UnHID")
 	bool GetFeatureReportBytes(const uint8 ReportId, const int32 Size, TArray<uint8>& Bytes, FString& ErrorMessage);
 
@@ -187,12 +769,55 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHIDDevice Get Report Descriptor"), Category = "UnHID")
 	TArray<uint8> GetReportDescriptor() const;
 
+	// Blueprint version, copies the whole reports tree (use the shared version from C++)
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Get Descriptor Reports"), Category = "UnHID")
 	bool GetDescriptorReports(FUnHIDDeviceDescriptorReports& DeviceDescriptorReports, FString& ErrorMessage);
 
+	// the descriptor data is immutable once parsed, so it can be shared (even with other threads) without copies
+	TSharedPtr<const FUnHIDDeviceDescriptorReports> GetDescriptorReportsShared(FString& ErrorMessage);
+
+	TSharedPtr<const class FUnHIDUsageIndex> GetUsageIndex(FString& ErrorMessage);
+
+	TSharedPtr<const class FUnHIDReportDecoder> GetReportDecoder(FString& ErrorMessage);
+
+	// all of the fields of an input report in a single pass, DecodedReport can be reused for every report
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Decode Report"), Category = "UnHID")
+	bool DecodeReport(const TArray<uint8>& Bytes, UPARAM(ref) FUnHIDDecodedReport& DecodedReport, FString& ErrorMessage);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHIDDevice Get Decoded Usage"), Category = "UnHID")
+	bool GetDecodedUsage(const FUnHIDDecodedReport& DecodedReport, const int32 UsagePage, const int32 Usage, int64& Value, float& NormalizedValue) const;
+
+	// every input report is compared with the previous one with the same id, the delegate is called once per report with the changed usages
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Start Change Detection"), Category = "UnHID")
+	bool StartChangeDetection(const FUnHIDUsagesChangedDynamicDelegate& OnUsagesChanged, FString& ErrorMessage);
+
+	bool StartChangeDetection(const FUnHIDUsagesChangedNativeDelegate& OnUsagesChanged, FString& ErrorMessage);
+
+	// as StartChangeDetection, but the delegate is called for each changed usage
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Start Usage Change Detection"), Category = "UnHID")
+	bool StartUsageChangeDetection(const FUnHIDUsageChangedDynamicDelegate& OnUsageChanged, FString& ErrorMessage);
+
+	bool StartUsageChangeDetection(const FUnHIDUsageChangedNativeDelegate& OnUsageChanged, FString& ErrorMessage);
+
+	// unbinds both of the delegates and forgets the previous reports
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Stop Change Detection"), Category = "UnHID")
+	void StopChangeDetection();
+
+	TSharedPtr<const TArray<uint8>> GetReportDescriptorShared() const
+	{
+		return ReportDescriptor;
+	}
+
 	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHIDDevice Get Device Info"), Category = "UnHID")
 	FUnHIDDeviceInfo GetDeviceInfo() const;
 
+	// bytes allocated for the input reports (the read buffers are sized from the report descriptor)
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHIDDevice Get Buffer Size"), Category = "UnHID")
+	int64 GetBufferSize() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "UnHIDDevice Get Read Stats"), Category = "UnHID")
+	FUnHIDDeviceReadStats GetReadStats() const;
+
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "UnHIDDevice Get BitOffset and BitSize from DescriptorReports and Usage"), Category = "UnHID")
 	bool GetBitOffsetAndSizeFromDescriptorReportsAndUsage(const int32 UsagePage, const int32 Usage, int64& BitOffset, int64& BitSize, FString& ErrorMessage);
 
@@ -216,11 +841,49 @@ public:
 	int64 ParseSignedIntegerFromBytesAndUsage(const TArray<uint8>& Bytes, const int32 UsagePage, const int32 Usage);
 
 protected:
+	bool OpenHidDevice(const FUnHIDDeviceInfo& UnHIDDeviceInfo, FString& ErrorMessage);
+	void StartWorkerThread(const FUnHIDDeviceReadOptions& InReadOptions);
+	class FUnHIDDeviceWriter* GetOrCreateWriter();
+	bool GetFeatureReportsSizes(const TArray<uint8>& ReportIds, TArray<int32>& Sizes, FString& ErrorMessage) const;
+	// lazily parses the descriptor reports (and builds the usage index)
+	bool ParseDescriptorReports(FString& ErrorMessage);
+	bool CanStartChangeDetection(FString& ErrorMessage);
+	// game thread only, returns false if a delegate terminated the device
+	bool DetectChanges(TArrayView<const uint8> Report);
+
 	void* HidDevice = nullptr;
 
+	class FUnHIDDeviceReader* UnHIDDeviceReader = nullptr;
 	class FUnHIDDeviceWorkerThread* UnHIDDeviceWorkerThread = nullptr;
+	// created on the first asynchronous write
+	class FUnHIDDeviceWriter* UnHIDDeviceWriter = nullptr;
+	FUnHIDDeviceWriteOptions WriteOptions;
+	// created with the reader
+	class FUnHIDResponseMatcher* UnHIDResponseMatcher = nullptr;
+	// the last started bulk transfer
+	class FUnHIDBulkTransfer* UnHIDBulkTransfer = nullptr;
 
 	TSharedPtr<TArray<uint8>> ReportDescriptor;
 	TSharedPtr<FUnHIDDeviceInfo> DeviceInfo;
-	TSharedPtr<FUnHIDDeviceDescriptorReports> DescriptorReports;
+	TSharedPtr<const FUnHIDDeviceDescriptorReports> DescriptorReports;
+	TSharedPtr<const class FUnHIDUsageIndex> UsageIndex;
+	TSharedPtr<const class FUnHIDReportDecoder> ReportDecoder;
+
+	// FUnHIDReadNativeDelegate is wrapped
+	FUnHIDReadWithTimestampNativeDelegate ReadNativeDelegate;
+	FUnHIDReadBatchNativeDelegate ReadBatchNativeDelegate;
+	FUnHIDReadAnyThreadNativeDelegate ReadAnyThreadNativeDelegate;
+	TArray<uint8> ReadReport;
+	FUnHIDReportBatch ReadReportBatch;
+	uint64 LastDroppedReports = 0;
+	bool bReadErrorDispatched = false;
+
+	FUnHIDUsagesChangedNativeDelegate UsagesChangedNativeDelegate;
+	FUnHIDUsageChangedNativeDelegate UsageChangedNativeDelegate;
+	// indexed by report id, reused between reports
+	TArray<TArray<uint8>> PreviousReports;
+	TArray<FUnHIDChangedUsage> ChangedUsages;
+
+	// hidapi functions sharing the hid_error() state (everything but the reads) can be called by multiple threads
+	FCriticalSection HidDeviceLock;
 };
@@ -0,0 +1,72 @@
+// Copyright 2026 - Roberto De Ioris
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnHIDDevice.h"
+
+/**
+ * Layout of every input report compiled once from the descriptor reports (immutable, safe to be used by any thread).
+ * Decode() extracts all of the fields of a report in a single pass into a caller owned FUnHIDDecodedReport.
+ */
+class UNHID_API FUnHIDReportDecoder
+{
+public:
+	FUnHIDReportDecoder(const FUnHIDDeviceDescriptorReports& DescriptorReports);
+
+	// DecodedReport arrays are resized only when the report layout changes
+	bool Decode(TArrayView<const uint8> Bytes, FUnHIDDecodedReport& DecodedReport) const;
+
+	// the fields of Report different from PreviousReport (missing bytes of PreviousReport are 0), compared 64 bits at a time
+	bool FindChangedUsages(TArrayView<const uint8> PreviousReport, TArrayView<const uint8> Report, TArray<FUnHIDChangedUsage>& ChangedUsages) const;
+
+	// looks up a field in the layout of DecodedReport.ReportId
+	bool GetUsage(const FUnHIDDecodedReport& DecodedReport, const int32 UsagePage, const int32 Usage, int64& Value, float& NormalizedValue) const;
+
+	bool HasReportIds() const
+	{
+		return bHasReportIds;
+	}
+
+private:
+	struct FUnHIDDecoderField
+	{
+		int64 UsagePage = 0;
+		int64 Usage = 0;
+		// from the beginning of the report (report id included)
+		int64 BitOffset = 0;
+		int64 BitSize = 0;
+		int64 LogicalMinimum = 0;
+		int64 LogicalMaximum = 0;
+		bool bSigned = false;
+		// single bit fields are packed in FUnHIDDecodedReport::Buttons
+		bool bButton = false;
+		// in Values/NormalizedValues or in the buttons bitset
+		int32 Index = 0;
+	};
+
+	struct FUnHIDDecoderLayout
+	{
+		int32 ReportId = 0;
+		TArray<FUnHIDDecoderField> Fields;
+		TMap<uint64, int32> FieldsByUsage;
+		// value fields in Index order, for UnHID::ExtractBitsBatch
+		TArray<int64> ValueBitOffsets;
+		TArray<int32> ValueBitSizes;
+		// for each 64 bits word of the report, the first field ending after its beginning (fields are sorted by BitOffset)
+		TArray<int32> FirstFieldByWord;
+		int32 NumValues = 0;
+		int32 NumButtons = 0;
+	};
+
+	// from the report id prefix (if any)
+	const FUnHIDDecoderLayout* FindReportLayout(TArrayView<const uint8> Bytes) const;
+	const FUnHIDDecoderLayout* FindLayout(const int32 ReportId) const;
+	// sign extension and normalization of the raw bits of a value field
+	static void DecodeValue(const FUnHIDDecoderField& Field, const uint64 Bits, int64& Value, float& NormalizedValue);
+
+	bool bHasReportIds = false;
+	// indexed by report id (INDEX_NONE for unknown report ids)
+	TArray<int32> LayoutsByReportId;
+	TArray<FUnHIDDecoderLayout> Layouts;
+};
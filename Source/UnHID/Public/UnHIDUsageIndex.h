@@ -0,0 +1,82 @@
+// Copyright 2026 - Roberto De Ioris
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnHIDDevice.h"
+
+namespace UnHID
+{
+	// (UsagePage, Usage) as a single hash key
+	inline uint64 GetUsageKey(const int64 UsagePage, const int64 Usage)
+	{
+		return (static_cast<uint64>(static_cast<uint32>(UsagePage)) << 32) | static_cast<uint32>(Usage);
+	}
+}
+
+// where a usage lives in a report (BitOffset includes the report id prefix, if any)
+struct FUnHIDUsageLocation
+{
+	int32 ReportId = 0;
+	int64 BitOffset = 0;
+	int64 BitSize = 0;
+	int64 LogicalMinimum = 0;
+	int64 LogicalMaximum = 0;
+};
+
+/**
+ * Immutable (UsagePage, Usage) lookup table built once from the descriptor reports (safe to be used by any thread).
+ * Results are the same of UUnHIDBlueprintFunctionLibrary::UnHIDGetDescriptorReportItemFromDescriptorReportsAndUsage
+ * (the first matching item wins), without scanning the reports.
+ */
+class UNHID_API FUnHIDUsageIndex
+{
+public:
+	FUnHIDUsageIndex(const FUnHIDDeviceDescriptorReports& DescriptorReports);
+
+	bool FindInput(const int32 UsagePage, const int32 Usage, FUnHIDUsageLocation& UsageLocation) const
+	{
+		return Inputs.Find(UsagePage, Usage, UsageLocation);
+	}
+
+	bool FindFeature(const int32 UsagePage, const int32 Usage, FUnHIDUsageLocation& UsageLocation) const
+	{
+		return Features.Find(UsagePage, Usage, UsageLocation);
+	}
+
+	// inputs first, then features
+	bool Find(const int32 UsagePage, const int32 Usage, FUnHIDUsageLocation& UsageLocation) const
+	{
+		return Inputs.Find(UsagePage, Usage, UsageLocation) || Features.Find(UsagePage, Usage, UsageLocation);
+	}
+
+private:
+	struct FUnHIDIndexedUsage
+	{
+		// position of the declaring item in the descriptor, the lowest one wins
+		int32 ItemOrdinal = 0;
+		FUnHIDUsageLocation UsageLocation;
+	};
+
+	// usage ranges too big to be expanded (vendor arrays) are kept as is and checked before the indexed usages of later items
+	struct FUnHIDUsageRange
+	{
+		int64 UsagePage = 0;
+		int64 UsageMinimum = 0;
+		int64 UsageMaximum = 0;
+		// location of UsageMinimum
+		FUnHIDIndexedUsage IndexedUsage;
+	};
+
+	struct FUnHIDUsageTable
+	{
+		void Build(const TArray<FUnHIDDeviceDescriptorReport>& Reports);
+		bool Find(const int32 UsagePage, const int32 Usage, FUnHIDUsageLocation& UsageLocation) const;
+
+		TMap<uint64, FUnHIDIndexedUsage> Usages;
+		TArray<FUnHIDUsageRange> UsageRanges;
+	};
+
+	FUnHIDUsageTable Inputs;
+	FUnHIDUsageTable Features;
+};
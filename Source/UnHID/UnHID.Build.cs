@@ -22,6 +22,12 @@ public class UnHID : ModuleRules
 			}
             );
 
+        // hidapi_hidraw.h (the hidraw file descriptor for the Linux reader service)
+        if (Target.Platform == UnrealTargetPlatform.Linux)
+        {
+            PrivateIncludePaths.Add(Path.Combine(ModuleDirectory, "..", "ThirdParty", "Hidapi", "Private", "Linux"));
+        }
+
 
         PublicDependencyModuleNames.AddRange(
             new string[]
@@ -9,6 +9,7 @@
 #include "Serialization/JsonSerializer.h"
 #include "Widgets/Input/SMultiLineEditableTextBox.h"
 #include "UnHIDBlueprintFunctionLibrary.h"
+#include "UnHIDDescriptorCache.h"
 
 #define LOCTEXT_NAMESPACE "FUnHIDEditorModule"
 
@@ -536,7 +537,18 @@ class SUnHIDDashboard : public SCompoundWidget
 		for (const FUnHIDDeviceInfo& DeviceInfo : DeviceInfos)
 		{
 			FString ErrorMessage;
-			TArray<uint8> ReportDescriptor = UUnHIDBlueprintFunctionLibrary::UnHIDGetReportDescriptor(DeviceInfo, ErrorMessage);
+			TArray<uint8> ReportDescriptor;
+			TSharedPtr<const FUnHIDDeviceDescriptorReports> DescriptorReports;
+			// known devices are neither opened nor parsed
+			if (!FUnHIDDescriptorCache::Get().FindReportDescriptor(DeviceInfo, ReportDescriptor, DescriptorReports))
+			{
+				ReportDescriptor = UUnHIDBlueprintFunctionLibrary::UnHIDGetReportDescriptor(DeviceInfo, ErrorMessage);
+				if (!ReportDescriptor.IsEmpty())
+				{
+					DescriptorReports = FUnHIDDescriptorCache::Get().GetOrParseDescriptorReports(DeviceInfo, ReportDescriptor, ErrorMessage);
+				}
+			}
+
 			TSharedRef<FUnHIDEditorDeviceInfo> EditorDeviceInfoRef = MakeShared<FUnHIDEditorDeviceInfo>();
 			EditorDeviceInfoRef->DeviceInfo = DeviceInfo;
 
@@ -547,7 +559,10 @@ class SUnHIDDashboard : public SCompoundWidget
 			else
 			{
 				EditorDeviceInfoRef->ReportDescriptor = UUnHIDBlueprintFunctionLibrary::UnHIDBytesToHexString(ReportDescriptor);
-				EditorDeviceInfoRef->Reports = UUnHIDBlueprintFunctionLibrary::UnHIDGetReportsFromReportDescriptorBytes(ReportDescriptor, ErrorMessage);
+				if (DescriptorReports.IsValid())
+				{
+					EditorDeviceInfoRef->Reports = *DescriptorReports;
+				}
 			}
 			HIDDeviceInfos.Add(EditorDeviceInfoRef);
 		}
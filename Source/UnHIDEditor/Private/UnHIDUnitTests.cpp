@@ -1,7 +1,13 @@
 // Copyright 2026 - Roberto De Ioris
 
 #if WITH_DEV_AUTOMATION_TESTS
+#include "UnHIDBitfield.h"
 #include "UnHIDBlueprintFunctionLibrary.h"
+#include "UnHIDBulkTransferFrames.h"
+#include "UnHIDDescriptorCache.h"
+#include "UnHIDDeviceReader.h"
+#include "UnHIDReportDecoder.h"
+#include "UnHIDUsageIndex.h"
 #include "Misc/AutomationTest.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDUnitTests_SingleByteToHexString, "UnHID.UnitTests.SingleByteToHexString", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
@@ -137,4 +143,790 @@ bool FUnHIDUnitTests_AssembleReport::RunTest(const FString& Parameters)
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDUnitTests_ReportBatch, "UnHID.UnitTests.ReportBatch", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnHIDUnitTests_ReportBatch::RunTest(const FString& Parameters)
+{
+	const uint8 Report0[] = { 0x01, 0x02, 0x03 };
+	const uint8 Report1[] = { 0x04 };
+
+	FUnHIDReportBatch ReportBatch;
+	ReportBatch.Add(Report0, 3, 100);
+	ReportBatch.Add(Report1, 1, 200);
+
+	TestEqual("ReportBatch.Num() == 2", ReportBatch.Num(), 2);
+	TestEqual("ReportBatch.Timestamps[1] == 200", ReportBatch.Timestamps[1], 200LL);
+	TestEqual("UnHIDGetReportFromReportBatch(ReportBatch, 0) == { 1, 2, 3 }", UUnHIDBlueprintFunctionLibrary::UnHIDGetReportFromReportBatch(ReportBatch, 0), { 1, 2, 3 });
+	TestEqual("UnHIDGetReportFromReportBatch(ReportBatch, 1) == { 4 }", UUnHIDBlueprintFunctionLibrary::UnHIDGetReportFromReportBatch(ReportBatch, 1), { 4 });
+	TestEqual("UnHIDGetReportFromReportBatch(ReportBatch, 2) == {}", UUnHIDBlueprintFunctionLibrary::UnHIDGetReportFromReportBatch(ReportBatch, 2), {});
+
+	ReportBatch.Reset();
+
+	TestEqual("ReportBatch.Num() == 0", ReportBatch.Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDUnitTests_SkipIdenticalReports, "UnHID.UnitTests.SkipIdenticalReports", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnHIDUnitTests_SkipIdenticalReports::RunTest(const FString& Parameters)
+{
+	FUnHIDDeviceReadOptions ReadOptions;
+	ReadOptions.QueuePolicy = EUnHIDReadQueuePolicy::DropNewest;
+	ReadOptions.MaxQueuedReports = 2;
+	ReadOptions.bSkipIdenticalReports = true;
+
+	// injected reports do not need a device
+	FUnHIDDeviceReader Reader(nullptr, ReadOptions, true, 3);
+
+	const uint8 ReportA[] = { 0x01, 0x0A, 0x00 };
+	const uint8 ReportB[] = { 0x01, 0x0B, 0x00 };
+	const uint8 OtherReportA[] = { 0x02, 0x0A, 0x00 };
+
+	Reader.InjectReport(ReportA, 3, 100);
+	Reader.InjectReport(ReportA, 3, 101);
+	// same payload, another report id
+	Reader.InjectReport(OtherReportA, 3, 102);
+	// the queue is full, a dropped report must not suppress its next copy
+	Reader.InjectReport(ReportB, 3, 103);
+	Reader.InjectReport(ReportB, 3, 104);
+
+	FUnHIDDeviceReadStats ReadStats;
+	Reader.GetReadStats(ReadStats);
+	TestEqual("ReadStats.EnqueuedReports == 2", ReadStats.EnqueuedReports, 2LL);
+	TestEqual("ReadStats.SuppressedReports == 1", ReadStats.SuppressedReports, 1LL);
+	TestEqual("ReadStats.DroppedReports == 2", ReadStats.DroppedReports, 2LL);
+
+	FUnHIDReportBatch ReportBatch;
+	Reader.CollectReports(ReportBatch);
+	TestEqual("ReportBatch.Num() == 2", ReportBatch.Num(), 2);
+	TestEqual("UnHIDGetReportFromReportBatch(ReportBatch, 0) == ReportA", UUnHIDBlueprintFunctionLibrary::UnHIDGetReportFromReportBatch(ReportBatch, 0), { 0x01, 0x0A, 0x00 });
+	TestEqual("ReportBatch.Timestamps[1] == 102", ReportBatch.Timestamps[1], 102LL);
+
+	// ReportA is still the last queued report of id 1
+	Reader.InjectReport(ReportA, 3, 105);
+	Reader.InjectReport(ReportB, 3, 106);
+
+	ReportBatch.Reset();
+	Reader.CollectReports(ReportBatch);
+	TestEqual("ReportBatch.Num() == 1", ReportBatch.Num(), 1);
+	TestEqual("UnHIDGetReportFromReportBatch(ReportBatch, 0) == ReportB", UUnHIDBlueprintFunctionLibrary::UnHIDGetReportFromReportBatch(ReportBatch, 0), { 0x01, 0x0B, 0x00 });
+	TestEqual("ReportBatch.Timestamps[0] == 106", ReportBatch.Timestamps[0], 106LL);
+
+	Reader.GetReadStats(ReadStats);
+	TestEqual("ReadStats.SuppressedReports == 2", ReadStats.SuppressedReports, 2LL);
+	TestEqual("ReadStats.DeliveredReports == 3", ReadStats.DeliveredReports, 3LL);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDUnitTests_DropOldestReports, "UnHID.UnitTests.DropOldestReports", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnHIDUnitTests_DropOldestReports::RunTest(const FString& Parameters)
+{
+	FUnHIDDeviceReadOptions ReadOptions;
+	ReadOptions.QueuePolicy = EUnHIDReadQueuePolicy::DropOldest;
+	ReadOptions.MaxQueuedReports = 2;
+
+	FUnHIDDeviceReader Reader(nullptr, ReadOptions, false, 1);
+
+	for (uint8 Value = 0; Value < 3; Value++)
+	{
+		Reader.InjectReport(&Value, 1, 100 + Value);
+	}
+
+	// the oldest report is discarded only when draining
+	TestEqual("Reader.GetNumPendingReports() == 2", Reader.GetNumPendingReports(), 2);
+
+	FUnHIDReportBatch ReportBatch;
+	Reader.CollectReports(ReportBatch);
+	TestEqual("ReportBatch.Num() == 2", ReportBatch.Num(), 2);
+	TestEqual("UnHIDGetReportFromReportBatch(ReportBatch, 0) == { 1 }", UUnHIDBlueprintFunctionLibrary::UnHIDGetReportFromReportBatch(ReportBatch, 0), { 1 });
+	TestEqual("ReportBatch.Timestamps[1] == 102", ReportBatch.Timestamps[1], 102LL);
+
+	FUnHIDDeviceReadStats ReadStats;
+	Reader.GetReadStats(ReadStats);
+	TestEqual("ReadStats.EnqueuedReports == 3", ReadStats.EnqueuedReports, 3LL);
+	TestEqual("ReadStats.DroppedReports == 1", ReadStats.DroppedReports, 1LL);
+	TestEqual("ReadStats.DeliveredReports == 2", ReadStats.DeliveredReports, 2LL);
+
+	// the spare slots are full, the new reports are discarded until the next drain
+	for (int32 Index = 0; Index < 5; Index++)
+	{
+		const uint8 Value = static_cast<uint8>(10 + Index);
+		Reader.InjectReport(&Value, 1, 200 + Index);
+	}
+
+	ReportBatch.Reset();
+	Reader.CollectReports(ReportBatch);
+	TestEqual("ReportBatch.Num() == 2", ReportBatch.Num(), 2);
+	TestEqual("UnHIDGetReportFromReportBatch(ReportBatch, 1) == { 13 }", UUnHIDBlueprintFunctionLibrary::UnHIDGetReportFromReportBatch(ReportBatch, 1), { 13 });
+
+	Reader.GetReadStats(ReadStats);
+	TestEqual("ReadStats.DroppedReports == 4", ReadStats.DroppedReports, 4LL);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDUnitTests_ReportRingBurst, "UnHID.UnitTests.ReportRingBurst", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnHIDUnitTests_ReportRingBurst::RunTest(const FString& Parameters)
+{
+	FUnHIDReportRing ReportRing(2, 1);
+
+	// a burst that fills the ring stays invisible until it is published
+	for (uint8 Value = 0; Value < 2; Value++)
+	{
+		uint8* WriteSlot = ReportRing.GetWriteSlot();
+		TestNotNull("WriteSlot != nullptr", WriteSlot);
+		*WriteSlot = Value;
+		ReportRing.CommitWriteSlot(1, Value, false);
+	}
+
+	TestNull("ReportRing.GetWriteSlot() == nullptr", ReportRing.GetWriteSlot());
+	TestEqual("ReportRing.NumCommitted() == 2", ReportRing.NumCommitted(), 2);
+	TestEqual("ReportRing.Num() == 0", ReportRing.Num(), 0);
+
+	ReportRing.Publish();
+	TestEqual("ReportRing.Num() == 2", ReportRing.Num(), 2);
+
+	ReportRing.Discard(1);
+	const uint8* Data = nullptr;
+	int32 Size = 0;
+	uint64 Timestamp = 0;
+	TestTrue("ReportRing.Peek()", ReportRing.Peek(Data, Size, Timestamp));
+	TestEqual("Data[0] == 1", Data[0], static_cast<uint8>(1));
+	TestEqual("Timestamp == 1", Timestamp, static_cast<uint64>(1));
+
+	ReportRing.Discard(2);
+	TestEqual("ReportRing.Num() == 0", ReportRing.Num(), 0);
+	TestNotNull("ReportRing.GetWriteSlot() != nullptr", ReportRing.GetWriteSlot());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDUnitTests_Timestamps, "UnHID.UnitTests.Timestamps", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnHIDUnitTests_Timestamps::RunTest(const FString& Parameters)
+{
+	const int64 Timestamp = UUnHIDBlueprintFunctionLibrary::UnHIDGetTimestampNow();
+	const int64 OneSecond = static_cast<int64>(1.0 / FPlatformTime::GetSecondsPerCycle64());
+
+	TestTrue("UnHIDGetTimestampNow() >= Timestamp", UUnHIDBlueprintFunctionLibrary::UnHIDGetTimestampNow() >= Timestamp);
+	TestEqual("UnHIDTimestampsDeltaToMilliseconds(Timestamp, Timestamp) == 0", UUnHIDBlueprintFunctionLibrary::UnHIDTimestampsDeltaToMilliseconds(Timestamp, Timestamp), 0.0);
+	TestEqual("UnHIDTimestampsDeltaToMilliseconds(Timestamp, Timestamp + OneSecond) == 1000", UUnHIDBlueprintFunctionLibrary::UnHIDTimestampsDeltaToMilliseconds(Timestamp, Timestamp + OneSecond), 1000.0, 0.01);
+	TestEqual("UnHIDTimestampsDeltaToMilliseconds(Timestamp + OneSecond, Timestamp) == -1000", UUnHIDBlueprintFunctionLibrary::UnHIDTimestampsDeltaToMilliseconds(Timestamp + OneSecond, Timestamp), -1000.0, 0.01);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDUnitTests_MatchBytesWithMask, "UnHID.UnitTests.MatchBytesWithMask", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnHIDUnitTests_MatchBytesWithMask::RunTest(const FString& Parameters)
+{
+	TestTrue("{ 1, 2, 3 } matches { 1, 2 }", UUnHIDBlueprintFunctionLibrary::UnHIDMatchBytesWithMask({ 1, 2, 3 }, { 1, 2 }, {}));
+	TestFalse("{ 1, 2, 3 } does not match { 1, 3 }", UUnHIDBlueprintFunctionLibrary::UnHIDMatchBytesWithMask({ 1, 2, 3 }, { 1, 3 }, {}));
+	TestTrue("{ 1, 2, 3 } matches { 1, 0, 3 } with mask { 0xFF, 0x00 }", UUnHIDBlueprintFunctionLibrary::UnHIDMatchBytesWithMask({ 1, 2, 3 }, { 1, 0, 3 }, { 0xFF, 0x00 }));
+	TestTrue("{ 0x12 } matches { 0x1F } with mask { 0xF0 }", UUnHIDBlueprintFunctionLibrary::UnHIDMatchBytesWithMask({ 0x12 }, { 0x1F }, { 0xF0 }));
+	TestFalse("{ 1 } does not match { 1, 2 }", UUnHIDBlueprintFunctionLibrary::UnHIDMatchBytesWithMask({ 1 }, { 1, 2 }, {}));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDUnitTests_FeaturePollResult, "UnHID.UnitTests.FeaturePollResult", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnHIDUnitTests_FeaturePollResult::RunTest(const FString& Parameters)
+{
+	const TArray<uint8> Report0 = { 0x02, 0x10, 0x20 };
+	const TArray<uint8> Report1 = { 0x02, 0x10, 0x21 };
+	const TArray<uint8> Report2 = { 0x02, 0x10 };
+
+	FUnHIDFeaturePollResult PollResult;
+
+	// only the polls different from the previous one are delivered
+	TestTrue("the first poll is delivered", PollResult.Update(true, Report0));
+	TestFalse("the same report is not delivered", PollResult.Update(true, Report0));
+	TestTrue("a different payload is delivered", PollResult.Update(true, Report1));
+	TestTrue("a shorter payload is delivered", PollResult.Update(true, Report2));
+	TestEqual("PollResult.Bytes == Report2", PollResult.Bytes, Report2);
+
+	TestTrue("a failure is delivered", PollResult.Update(false, Report2));
+	TestTrue("PollResult.Bytes is empty after a failure", PollResult.Bytes.IsEmpty());
+	TestFalse("a failure after a failure is not delivered (even with different bytes)", PollResult.Update(false, Report0));
+	TestTrue("the report before the failure is delivered again", PollResult.Update(true, Report2));
+
+	FUnHIDFeaturePollResult FailedPollResult;
+	TestTrue("a failed first poll is delivered", FailedPollResult.Update(false, {}));
+	TestTrue("an empty successful report after a failure is delivered", FailedPollResult.Update(true, {}));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDUnitTests_BulkTransferFrames, "UnHID.UnitTests.BulkTransferFrames", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnHIDUnitTests_BulkTransferFrames::RunTest(const FString& Parameters)
+{
+	const TArray<uint8> Data = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09 };
+	const TAtomic<bool> bNotCancelled(false);
+
+	FUnHIDBulkTransferOptions BulkTransferOptions;
+	BulkTransferOptions.ReportId = 0x07;
+	BulkTransferOptions.MaxRetries = 2;
+
+	// every frame is recorded, FailedCalls are the (0 based) calls returning false
+	TArray<TArray<uint8>> SentFrames;
+	TArray<bool> AwaitedAcks;
+	TArray<int32> FailedCalls;
+	auto SendFrame = [&](const TArray<uint8>& Frame, const bool bAwaitAck, FString& ErrorMessage)
+		{
+			const bool bFailed = FailedCalls.Contains(SentFrames.Num());
+			SentFrames.Add(Frame);
+			AwaitedAcks.Add(bAwaitAck);
+			if (bFailed)
+			{
+				ErrorMessage = "Failed";
+			}
+			return !bFailed;
+		};
+
+	{
+		FUnHIDBulkTransferFrames Frames(Data, BulkTransferOptions, 4);
+		TestEqual("GetNumFrames() == 3", Frames.GetNumFrames(), 3);
+
+		FString ErrorMessage;
+		TestTrue("Send()", Frames.Send(SendFrame, bNotCancelled, ErrorMessage));
+		TestEqual("SentFrames.Num() == 3", SentFrames.Num(), 3);
+		TestEqual("SentFrames[0] == { 0x07, 0x00, 0x01, 0x02, 0x03 }", SentFrames[0], TArray<uint8>({ 0x07, 0x00, 0x01, 0x02, 0x03 }));
+		TestEqual("SentFrames[2] == { 0x07, 0x08, 0x09, 0x00, 0x00 }", SentFrames[2], TArray<uint8>({ 0x07, 0x08, 0x09, 0x00, 0x00 }));
+		TestFalse("AwaitedAcks.Contains(true) == false", AwaitedAcks.Contains(true));
+
+		FUnHIDBulkTransferStats Stats;
+		Frames.Complete(true, ErrorMessage, Stats);
+		TestTrue("Stats.bCompleted == true", Stats.bCompleted);
+		TestEqual("Stats.TotalBytes == 10", Stats.TotalBytes, 10LL);
+		TestEqual("Stats.SentFrames == 3", Stats.SentFrames, 3LL);
+		TestEqual("Stats.SentBytes == 10", Stats.SentBytes, 10LL);
+		TestEqual("Stats.Progress == 1", Stats.Progress, 1.0f);
+		TestEqual("Stats.Retries == 0", Stats.Retries, 0);
+	}
+
+	// without windows only the failed frame is sent again
+	{
+		SentFrames.Reset();
+		AwaitedAcks.Reset();
+		FailedCalls = { 1 };
+
+		FUnHIDBulkTransferFrames Frames(Data, BulkTransferOptions, 4);
+		FString ErrorMessage;
+		TestTrue("Send(a failed frame)", Frames.Send(SendFrame, bNotCancelled, ErrorMessage));
+		TestEqual("SentFrames.Num() == 4", SentFrames.Num(), 4);
+		TestEqual("SentFrames[2] == SentFrames[1]", SentFrames[2], SentFrames[1]);
+
+		FUnHIDBulkTransferStats Stats;
+		Frames.GetStats(Stats);
+		TestEqual("Stats.Retries == 1", Stats.Retries, 1);
+		TestEqual("Stats.SentFrames == 3", Stats.SentFrames, 3LL);
+	}
+
+	{
+		SentFrames.Reset();
+		AwaitedAcks.Reset();
+		FailedCalls = { 1, 2, 3 };
+
+		FUnHIDBulkTransferFrames Frames(Data, BulkTransferOptions, 4);
+		FString ErrorMessage;
+		TestFalse("Send(a frame failing MaxRetries + 1 times)", Frames.Send(SendFrame, bNotCancelled, ErrorMessage));
+		TestEqual("ErrorMessage == Failed", ErrorMessage, FString("Failed"));
+
+		FUnHIDBulkTransferStats Stats;
+		Frames.GetStats(Stats);
+		TestEqual("Stats.Retries == 2", Stats.Retries, 2);
+		TestEqual("Stats.SentFrames == 1", Stats.SentFrames, 1LL);
+		TestEqual("Stats.SentBytes == 4", Stats.SentBytes, 4LL);
+		TestEqual("Stats.Progress == 0.4", Stats.Progress, 0.4f, 0.0001f);
+	}
+
+	// with windows the whole window is sent again, the progress is updated by the acknowledgements
+	BulkTransferOptions.WindowSize = 2;
+	BulkTransferOptions.MaxRetries = 1;
+
+	{
+		SentFrames.Reset();
+		AwaitedAcks.Reset();
+		FailedCalls = { 1 };
+
+		FUnHIDBulkTransferFrames Frames(Data, BulkTransferOptions, 4);
+		FString ErrorMessage;
+		TestTrue("Send(windows, a missing acknowledgement)", Frames.Send(SendFrame, bNotCancelled, ErrorMessage));
+		TestEqual("SentFrames.Num() == 5", SentFrames.Num(), 5);
+		TestEqual("AwaitedAcks == { false, true, false, true, true }", AwaitedAcks, TArray<bool>({ false, true, false, true, true }));
+		TestEqual("SentFrames[2] == SentFrames[0]", SentFrames[2], SentFrames[0]);
+
+		FUnHIDBulkTransferStats Stats;
+		Frames.GetStats(Stats);
+		TestEqual("Stats.Retries == 1", Stats.Retries, 1);
+		TestEqual("Stats.SentFrames == 3", Stats.SentFrames, 3LL);
+		TestEqual("Stats.SentBytes == 10", Stats.SentBytes, 10LL);
+	}
+
+	{
+		SentFrames.Reset();
+		AwaitedAcks.Reset();
+		FailedCalls = { 0, 1 };
+
+		FUnHIDBulkTransferFrames Frames(Data, BulkTransferOptions, 4);
+		FString ErrorMessage;
+		TestFalse("Send(windows, a window failing MaxRetries + 1 times)", Frames.Send(SendFrame, bNotCancelled, ErrorMessage));
+		// a failed frame is not sent again on its own
+		TestEqual("SentFrames.Num() == 2", SentFrames.Num(), 2);
+
+		FUnHIDBulkTransferStats Stats;
+		Frames.GetStats(Stats);
+		TestEqual("Stats.Retries == 1", Stats.Retries, 1);
+		TestEqual("Stats.SentFrames == 0", Stats.SentFrames, 0LL);
+		TestEqual("Stats.Progress == 0", Stats.Progress, 0.0f);
+	}
+
+	{
+		SentFrames.Reset();
+		FailedCalls.Reset();
+
+		const TAtomic<bool> bCancelled(true);
+		FUnHIDBulkTransferFrames Frames(Data, BulkTransferOptions, 4);
+		FString ErrorMessage;
+		TestFalse("Send(cancelled)", Frames.Send(SendFrame, bCancelled, ErrorMessage));
+		TestEqual("ErrorMessage == Cancelled", ErrorMessage, FString("Cancelled"));
+		TestEqual("SentFrames.Num() == 0", SentFrames.Num(), 0);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDUnitTests_UsageIndex, "UnHID.UnitTests.UsageIndex", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnHIDUnitTests_UsageIndex::RunTest(const FString& Parameters)
+{
+	const FString ReportDescriptor = R"(
+05 01 09 05 A1 01 85 01 05 09 19 01 29 10 15 00 25 01 75 01 95 10 81 02 05 01 09 30 09 31 15 00
+26 FF 00 75 08 95 02 81 02 85 02 09 30 15 00 26 FF 0F 75 10 95 01 B1 02 C0
+	)";
+
+	FString ErrorMessage;
+	const FUnHIDDeviceDescriptorReports DescriptorReports = UUnHIDBlueprintFunctionLibrary::UnHIDGetReportsFromReportDescriptorBytes(UUnHIDBlueprintFunctionLibrary::UnHIDHexStringToBytes(ReportDescriptor), ErrorMessage);
+	TestTrue("DescriptorReports.bValid == true", DescriptorReports.bValid);
+
+	const FUnHIDUsageIndex UsageIndex(DescriptorReports);
+
+	// every lookup must match the linear scan
+	const TArray<TPair<int32, int32>> Usages = { { 0x09, 0x01 }, { 0x09, 0x10 }, { 0x09, 0x11 }, { 0x01, 0x30 }, { 0x01, 0x31 }, { 0x01, 0x32 } };
+	for (const TPair<int32, int32>& Usage : Usages)
+	{
+		FUnHIDDeviceDescriptorReportItem DescriptorReportItem;
+		const bool bFound = UUnHIDBlueprintFunctionLibrary::UnHIDGetDescriptorReportItemFromDescriptorReportsAndUsage(DescriptorReports.Inputs, Usage.Key, Usage.Value, DescriptorReportItem);
+
+		FUnHIDUsageLocation UsageLocation;
+		TestEqual(FString::Printf(TEXT("FindInput(0x%02X, 0x%02X) found"), Usage.Key, Usage.Value), UsageIndex.FindInput(Usage.Key, Usage.Value, UsageLocation), bFound);
+		if (bFound)
+		{
+			TestEqual(FString::Printf(TEXT("FindInput(0x%02X, 0x%02X) BitOffset"), Usage.Key, Usage.Value), UsageLocation.BitOffset, DescriptorReportItem.BitOffset);
+			TestEqual(FString::Printf(TEXT("FindInput(0x%02X, 0x%02X) BitSize"), Usage.Key, Usage.Value), UsageLocation.BitSize, DescriptorReportItem.BitSize);
+		}
+	}
+
+	FUnHIDUsageLocation FeatureUsageLocation;
+	TestTrue("FindFeature(0x01, 0x30)", UsageIndex.FindFeature(0x01, 0x30, FeatureUsageLocation));
+	TestEqual("FindFeature(0x01, 0x30).ReportId == 2", FeatureUsageLocation.ReportId, 2);
+	TestEqual("FindFeature(0x01, 0x30).LogicalMaximum == 4095", FeatureUsageLocation.LogicalMaximum, static_cast<int64>(4095));
+
+	// a vendor range too big to be expanded, followed by an item declaring one of its usages
+	const FString VendorReportDescriptor = R"(
+06 00 FF 09 01 A1 01 19 00 2A FF 07 15 00 25 01 75 01 96 00 08 81 02 09 10 26 FF 00 75 08 95 01 81 02 C0
+	)";
+
+	const FUnHIDDeviceDescriptorReports VendorDescriptorReports = UUnHIDBlueprintFunctionLibrary::UnHIDGetReportsFromReportDescriptorBytes(UUnHIDBlueprintFunctionLibrary::UnHIDHexStringToBytes(VendorReportDescriptor), ErrorMessage);
+	TestTrue("VendorDescriptorReports.bValid == true", VendorDescriptorReports.bValid);
+
+	const FUnHIDUsageIndex VendorUsageIndex(VendorDescriptorReports);
+
+	// the earlier item wins, as in the linear scan
+	FUnHIDDeviceDescriptorReportItem VendorDescriptorReportItem;
+	TestTrue("UnHIDGetDescriptorReportItemFromDescriptorReportsAndUsage(0xFF00, 0x10)", UUnHIDBlueprintFunctionLibrary::UnHIDGetDescriptorReportItemFromDescriptorReportsAndUsage(VendorDescriptorReports.Inputs, 0xFF00, 0x10, VendorDescriptorReportItem));
+
+	FUnHIDUsageLocation VendorUsageLocation;
+	TestTrue("FindInput(0xFF00, 0x10)", VendorUsageIndex.FindInput(0xFF00, 0x10, VendorUsageLocation));
+	TestEqual("FindInput(0xFF00, 0x10) BitOffset", VendorUsageLocation.BitOffset, VendorDescriptorReportItem.BitOffset);
+	TestEqual("FindInput(0xFF00, 0x10) BitSize == 1", VendorUsageLocation.BitSize, static_cast<int64>(1));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDUnitTests_DescriptorCacheSerialization, "UnHID.UnitTests.DescriptorCacheSerialization", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnHIDUnitTests_DescriptorCacheSerialization::RunTest(const FString& Parameters)
+{
+	const TArray<uint8> ReportDescriptor = UUnHIDBlueprintFunctionLibrary::UnHIDHexStringToBytes(R"(
+05 01 09 05 A1 01 85 01 05 09 19 01 29 10 15 00 25 01 75 01 95 10 81 02 05 01 09 30 09 31 15 00
+26 FF 00 75 08 95 02 81 02 85 02 09 30 15 00 26 FF 0F 75 10 95 01 B1 02 C0
+	)");
+
+	FString ErrorMessage;
+	const TSharedPtr<const FUnHIDDeviceDescriptorReports> DescriptorReports = MakeShared<const FUnHIDDeviceDescriptorReports>(UUnHIDBlueprintFunctionLibrary::UnHIDGetReportsFromReportDescriptorBytes(ReportDescriptor, ErrorMessage));
+	TestTrue("DescriptorReports.bValid == true", DescriptorReports->bValid);
+
+	FUnHIDDeviceInfo DeviceInfo;
+	DeviceInfo.VendorId = 0x1234;
+	DeviceInfo.ProductId = 0x5678;
+	DeviceInfo.ReleaseNumber = 0x0100;
+	DeviceInfo.InterfaceNumber = -1;
+	DeviceInfo.UsagePage = 0xFF00;
+	DeviceInfo.Usage = 0x01;
+
+	TArray<FUnHIDDescriptorCache::FUnHIDDescriptorCacheEntry> Entries;
+	Entries.Add(FUnHIDDescriptorCache::MakeEntry(DeviceInfo, ReportDescriptor, DescriptorReports));
+
+	TArray<uint8> Bytes;
+	FUnHIDDescriptorCache::SaveEntriesToBytes(Entries, Bytes);
+
+	TArray<FUnHIDDescriptorCache::FUnHIDDescriptorCacheEntry> LoadedEntries;
+	TestTrue("LoadEntriesFromBytes(Bytes)", FUnHIDDescriptorCache::LoadEntriesFromBytes(Bytes, LoadedEntries));
+	if (!TestEqual("LoadedEntries.Num() == 1", LoadedEntries.Num(), 1))
+	{
+		return false;
+	}
+
+	const FUnHIDDescriptorCache::FUnHIDDescriptorCacheEntry& LoadedEntry = LoadedEntries[0];
+	TestEqual("LoadedEntry.VendorId == 0x1234", LoadedEntry.VendorId, 0x1234);
+	TestEqual("LoadedEntry.InterfaceNumber == -1", LoadedEntry.InterfaceNumber, -1);
+	TestEqual("LoadedEntry.UsagePage == 0xFF00", LoadedEntry.UsagePage, 0xFF00);
+	TestEqual("LoadedEntry.ReportDescriptor == ReportDescriptor", LoadedEntry.ReportDescriptor, ReportDescriptor);
+	if (!TestTrue("LoadedEntry.DescriptorReports->bValid == true", LoadedEntry.DescriptorReports.IsValid() && LoadedEntry.DescriptorReports->bValid))
+	{
+		return false;
+	}
+
+	// the parsed reports survive the round trip
+	TestEqual("Inputs.Num()", LoadedEntry.DescriptorReports->Inputs.Num(), DescriptorReports->Inputs.Num());
+	TestEqual("Features.Num()", LoadedEntry.DescriptorReports->Features.Num(), DescriptorReports->Features.Num());
+	for (int32 ReportIndex = 0; ReportIndex < FMath::Min(LoadedEntry.DescriptorReports->Inputs.Num(), DescriptorReports->Inputs.Num()); ReportIndex++)
+	{
+		const FUnHIDDeviceDescriptorReport& Report = DescriptorReports->Inputs[ReportIndex];
+		const FUnHIDDeviceDescriptorReport& LoadedReport = LoadedEntry.DescriptorReports->Inputs[ReportIndex];
+		TestEqual(FString::Printf(TEXT("Inputs[%d].ReportId"), ReportIndex), LoadedReport.ReportId, Report.ReportId);
+		TestEqual(FString::Printf(TEXT("Inputs[%d].Items.Num()"), ReportIndex), LoadedReport.Items.Num(), Report.Items.Num());
+		for (int32 ItemIndex = 0; ItemIndex < FMath::Min(LoadedReport.Items.Num(), Report.Items.Num()); ItemIndex++)
+		{
+			TestEqual(FString::Printf(TEXT("Inputs[%d].Items[%d].BitOffset"), ReportIndex, ItemIndex), LoadedReport.Items[ItemIndex].BitOffset, Report.Items[ItemIndex].BitOffset);
+			TestEqual(FString::Printf(TEXT("Inputs[%d].Items[%d].Usage"), ReportIndex, ItemIndex), LoadedReport.Items[ItemIndex].Usage, Report.Items[ItemIndex].Usage);
+			TestEqual(FString::Printf(TEXT("Inputs[%d].Items[%d].LogicalMaximum"), ReportIndex, ItemIndex), LoadedReport.Items[ItemIndex].LogicalMaximum, Report.Items[ItemIndex].LogicalMaximum);
+		}
+	}
+
+	// every truncation is detected
+	for (int32 Size = 0; Size < Bytes.Num(); Size++)
+	{
+		if (FUnHIDDescriptorCache::LoadEntriesFromBytes(TArray<uint8>(Bytes.GetData(), Size), LoadedEntries) || LoadedEntries.Num() > 0)
+		{
+			AddError(FString::Printf(TEXT("LoadEntriesFromBytes() accepted %d of %d bytes"), Size, Bytes.Num()));
+			return false;
+		}
+	}
+
+	// an altered report descriptor is detected
+	int32 ReportDescriptorOffset = INDEX_NONE;
+	for (int32 Offset = 0; Offset + ReportDescriptor.Num() <= Bytes.Num(); Offset++)
+	{
+		if (FMemory::Memcmp(Bytes.GetData() + Offset, ReportDescriptor.GetData(), ReportDescriptor.Num()) == 0)
+		{
+			ReportDescriptorOffset = Offset;
+			break;
+		}
+	}
+	TestTrue("ReportDescriptorOffset != INDEX_NONE", ReportDescriptorOffset != INDEX_NONE);
+	TArray<uint8> CorruptedBytes = Bytes;
+	CorruptedBytes[FMath::Max(ReportDescriptorOffset, 0) + 1] ^= 0xFF;
+	TestFalse("LoadEntriesFromBytes(altered report descriptor)", FUnHIDDescriptorCache::LoadEntriesFromBytes(CorruptedBytes, LoadedEntries));
+
+	CorruptedBytes = Bytes;
+	CorruptedBytes[0] ^= 0xFF;
+	TestFalse("LoadEntriesFromBytes(bad magic)", FUnHIDDescriptorCache::LoadEntriesFromBytes(CorruptedBytes, LoadedEntries));
+
+	// the version is the (zigzag) varint just after the 32 bit magic
+	CorruptedBytes = Bytes;
+	CorruptedBytes[4] += 2;
+	TestFalse("LoadEntriesFromBytes(another version)", FUnHIDDescriptorCache::LoadEntriesFromBytes(CorruptedBytes, LoadedEntries));
+
+	// the parsed reports follow the report descriptor and are covered by the checksum
+	CorruptedBytes = Bytes;
+	CorruptedBytes[Bytes.Num() - sizeof(uint64) - 1] ^= 0x01;
+	TestFalse("LoadEntriesFromBytes(altered parsed reports)", FUnHIDDescriptorCache::LoadEntriesFromBytes(CorruptedBytes, LoadedEntries));
+
+	// a correctly checksummed file with an item outside of its report is rejected too
+	FUnHIDDeviceDescriptorReports InvalidDescriptorReports = *DescriptorReports;
+	InvalidDescriptorReports.Inputs[0].Items[0].BitOffset = InvalidDescriptorReports.Inputs[0].NumBits;
+	InvalidDescriptorReports.Inputs[0].Items[0].Count = 1;
+	InvalidDescriptorReports.Inputs[0].Items[0].BitSize = 8;
+	Entries.Reset();
+	Entries.Add(FUnHIDDescriptorCache::MakeEntry(DeviceInfo, ReportDescriptor, MakeShared<const FUnHIDDeviceDescriptorReports>(MoveTemp(InvalidDescriptorReports))));
+	FUnHIDDescriptorCache::SaveEntriesToBytes(Entries, Bytes);
+	TestFalse("LoadEntriesFromBytes(item outside of its report)", FUnHIDDescriptorCache::LoadEntriesFromBytes(Bytes, LoadedEntries));
+	TestEqual("LoadedEntries.Num() == 0", LoadedEntries.Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDUnitTests_ReportDecoder, "UnHID.UnitTests.ReportDecoder", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnHIDUnitTests_ReportDecoder::RunTest(const FString& Parameters)
+{
+	// 16 buttons and two signed 8 bit axis
+	const FString ReportDescriptor = R"(
+05 01 09 05 A1 01 85 01 05 09 19 01 29 10 15 00 25 01 75 01 95 10 81 02 05 01 09 30 09 31 15 81
+25 7F 75 08 95 02 81 02 C0
+	)";
+
+	FString ErrorMessage;
+	const FUnHIDDeviceDescriptorReports DescriptorReports = UUnHIDBlueprintFunctionLibrary::UnHIDGetReportsFromReportDescriptorBytes(UUnHIDBlueprintFunctionLibrary::UnHIDHexStringToBytes(ReportDescriptor), ErrorMessage);
+	TestTrue("DescriptorReports.bValid == true", DescriptorReports.bValid);
+
+	const FUnHIDReportDecoder ReportDecoder(DescriptorReports);
+
+	FUnHIDDecodedReport DecodedReport;
+	const TArray<uint8> Report = { 0x01, 0x05, 0x80, 0x7F, 0xFF };
+	TestTrue("Decode()", ReportDecoder.Decode(Report, DecodedReport));
+	TestFalse("Decode() with unknown report id", ReportDecoder.Decode(TArray<uint8>({ 0x02, 0x00 }), DecodedReport));
+	TestTrue("Decode()", ReportDecoder.Decode(Report, DecodedReport));
+
+	TestEqual("DecodedReport.ReportId == 1", DecodedReport.ReportId, 1);
+	TestEqual("DecodedReport.Buttons.NumBits == 16", DecodedReport.Buttons.NumBits, 16);
+	TestEqual("DecodedReport.Buttons.Words[0] == 0x8005", DecodedReport.Buttons.Words[0], static_cast<int64>(0x8005));
+	TestEqual("DecodedReport.Values.Num() == 2", DecodedReport.Values.Num(), 2);
+
+	int64 Value = 0;
+	float NormalizedValue = 0;
+	TestTrue("GetUsage(0x01, 0x30)", ReportDecoder.GetUsage(DecodedReport, 0x01, 0x30, Value, NormalizedValue));
+	TestEqual("X == 127", Value, static_cast<int64>(127));
+	TestEqual("X normalized == 1", NormalizedValue, 1.0f);
+	TestTrue("GetUsage(0x01, 0x31)", ReportDecoder.GetUsage(DecodedReport, 0x01, 0x31, Value, NormalizedValue));
+	TestEqual("Y == -1", Value, static_cast<int64>(-1));
+	TestTrue("GetUsage(0x09, 0x10)", ReportDecoder.GetUsage(DecodedReport, 0x09, 0x10, Value, NormalizedValue));
+	TestEqual("Button 16 == 1", Value, static_cast<int64>(1));
+	TestTrue("GetUsage(0x09, 0x02)", ReportDecoder.GetUsage(DecodedReport, 0x09, 0x02, Value, NormalizedValue));
+	TestEqual("Button 2 == 0", Value, static_cast<int64>(0));
+
+	return true;
+}
+
+namespace UnHIDUnitTests
+{
+	// the original bit by bit implementation of UnHIDParseUnsignedIntegerFromBytes
+	static uint64 ExtractBitsReference(const TArray<uint8>& Bytes, const int64 BitOffset, const int64 BitSize)
+	{
+		uint64 Value = 0;
+		for (int64 Index = 0; Index < BitSize; Index++)
+		{
+			const uint64 BitIndex = BitOffset + Index;
+			if (!Bytes.IsValidIndex(BitIndex / 8))
+			{
+				break;
+			}
+			Value |= static_cast<uint64>((Bytes[BitIndex / 8] >> (BitIndex % 8)) & 1) << Index;
+		}
+		return Value;
+	}
+
+	static void FillRandomFields(FRandomStream& RandomStream, TArray<uint8>& Bytes, TArray<int64>& BitOffsets, TArray<int32>& BitSizes, const int32 NumBytes, const int32 NumFields)
+	{
+		Bytes.SetNumUninitialized(NumBytes);
+		for (uint8& Byte : Bytes)
+		{
+			Byte = static_cast<uint8>(RandomStream.RandHelper(256));
+		}
+
+		BitOffsets.SetNumUninitialized(NumFields);
+		BitSizes.SetNumUninitialized(NumFields);
+		for (int32 Index = 0; Index < NumFields; Index++)
+		{
+			// a few of them after the end of the report
+			BitOffsets[Index] = RandomStream.RandHelper(NumBytes * 8 + 16);
+			BitSizes[Index] = RandomStream.RandRange(1, 64);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDUnitTests_ChangedUsages, "UnHID.UnitTests.ChangedUsages", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnHIDUnitTests_ChangedUsages::RunTest(const FString& Parameters)
+{
+	// 16 buttons and two signed 8 bit axis
+	const FString ReportDescriptor = R"(
+05 01 09 05 A1 01 85 01 05 09 19 01 29 10 15 00 25 01 75 01 95 10 81 02 05 01 09 30 09 31 15 81
+25 7F 75 08 95 02 81 02 C0
+	)";
+
+	FString ErrorMessage;
+	const FUnHIDReportDecoder ReportDecoder(UUnHIDBlueprintFunctionLibrary::UnHIDGetReportsFromReportDescriptorBytes(UUnHIDBlueprintFunctionLibrary::UnHIDHexStringToBytes(ReportDescriptor), ErrorMessage));
+
+	TArray<FUnHIDChangedUsage> ChangedUsages;
+	const TArray<uint8> PreviousReport = { 0x01, 0x05, 0x80, 0x7F, 0xFF };
+
+	TestTrue("FindChangedUsages(same report)", ReportDecoder.FindChangedUsages(PreviousReport, PreviousReport, ChangedUsages));
+	TestEqual("ChangedUsages.Num() == 0", ChangedUsages.Num(), 0);
+
+	// button 1 released, Y from -1 to 2
+	TestTrue("FindChangedUsages()", ReportDecoder.FindChangedUsages(PreviousReport, TArray<uint8>({ 0x01, 0x04, 0x80, 0x7F, 0x02 }), ChangedUsages));
+	TestEqual("ChangedUsages.Num() == 2", ChangedUsages.Num(), 2);
+	if (ChangedUsages.Num() == 2)
+	{
+		TestEqual("ChangedUsages[0].Usage == 1", ChangedUsages[0].Usage, 1);
+		TestEqual("ChangedUsages[0].Value == 0", ChangedUsages[0].Value, static_cast<int64>(0));
+		TestEqual("ChangedUsages[0].PreviousValue == 1", ChangedUsages[0].PreviousValue, static_cast<int64>(1));
+		TestEqual("ChangedUsages[1].Usage == 0x31", ChangedUsages[1].Usage, 0x31);
+		TestEqual("ChangedUsages[1].Value == 2", ChangedUsages[1].Value, static_cast<int64>(2));
+		TestEqual("ChangedUsages[1].PreviousValue == -1", ChangedUsages[1].PreviousValue, static_cast<int64>(-1));
+	}
+
+	// the first report is compared with zeros
+	TestTrue("FindChangedUsages(no previous report)", ReportDecoder.FindChangedUsages({}, PreviousReport, ChangedUsages));
+	TestEqual("ChangedUsages.Num() == 5", ChangedUsages.Num(), 5);
+
+	TestFalse("FindChangedUsages(unknown report id)", ReportDecoder.FindChangedUsages(PreviousReport, TArray<uint8>({ 0x02, 0x00 }), ChangedUsages));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDUnitTests_ExtractBits, "UnHID.UnitTests.ExtractBits", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnHIDUnitTests_ExtractBits::RunTest(const FString& Parameters)
+{
+	FRandomStream RandomStream(17);
+	TArray<uint8> Bytes;
+	TArray<int64> BitOffsets;
+	TArray<int32> BitSizes;
+	TArray<uint64> Values;
+
+	for (int32 Iteration = 0; Iteration < 1000; Iteration++)
+	{
+		const int32 NumFields = RandomStream.RandRange(0, 13);
+		UnHIDUnitTests::FillRandomFields(RandomStream, Bytes, BitOffsets, BitSizes, RandomStream.RandRange(1, 40), NumFields);
+		Values.SetNumUninitialized(NumFields);
+
+		UnHID::ExtractBitsBatch(Bytes, BitOffsets, BitSizes, Values);
+		for (int32 Index = 0; Index < NumFields; Index++)
+		{
+			const uint64 Expected = UnHIDUnitTests::ExtractBitsReference(Bytes, BitOffsets[Index], BitSizes[Index]);
+			if (UnHID::ExtractBits(Bytes, BitOffsets[Index], BitSizes[Index]) != Expected || Values[Index] != Expected)
+			{
+				AddError(FString::Printf(TEXT("ExtractBits(%lld, %d) mismatch in iteration %d"), BitOffsets[Index], BitSizes[Index], Iteration));
+				return false;
+			}
+		}
+	}
+
+	const TArray<uint8> Data = { 0xA5, 0x0F };
+	TestEqual("UnHIDParseBitmaskFromBytes({ 0xA5, 0x0F }, 4, 8) == { 0, 1, 0, 1, 1, 1, 1, 1 }", UUnHIDBlueprintFunctionLibrary::UnHIDParseBitmaskFromBytes(Data, 4, 8), TArray<bool>({ false, true, false, true, true, true, true, true }));
+	TestEqual("UnHIDParseBitmaskFromBytes({ 0xA5, 0x0F }, 12, 100).Num() == 4", UUnHIDBlueprintFunctionLibrary::UnHIDParseBitmaskFromBytes(Data, 12, 100).Num(), 4);
+	TestEqual("UnHIDParseBitmaskFromBytes({ 0xA5, 0x0F }, 16, 8).Num() == 0", UUnHIDBlueprintFunctionLibrary::UnHIDParseBitmaskFromBytes(Data, 16, 8).Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDUnitTests_Bitset, "UnHID.UnitTests.Bitset", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FUnHIDUnitTests_Bitset::RunTest(const FString& Parameters)
+{
+	// 128 buttons after the report id, buttons 1, 63, 64 and 127 pressed
+	TArray<uint8> Report;
+	Report.AddZeroed(17);
+	Report[0] = 0x01;
+	Report[1] = 0x02;
+	Report[8] = 0x80;
+	Report[9] = 0x01;
+	Report[16] = 0x80;
+
+	const FUnHIDBitset Bitset = UUnHIDBlueprintFunctionLibrary::UnHIDParseBitsetFromBytes(Report, 8, 128);
+	TestEqual("Bitset.NumBits == 128", Bitset.NumBits, 128);
+	TestEqual("Bitset.Words.Num() == 2", Bitset.Words.Num(), 2);
+	TestEqual("CountSetBits() == 4", Bitset.CountSetBits(), 4);
+	TestTrue("IsSet(63)", Bitset.IsSet(63));
+	TestFalse("IsSet(62)", Bitset.IsSet(62));
+	TestFalse("IsSet(128)", Bitset.IsSet(128));
+	TestEqual("UnHIDBitsetGetSetBits() == { 1, 63, 64, 127 }", UUnHIDBlueprintFunctionLibrary::UnHIDBitsetGetSetBits(Bitset), TArray<int32>({ 1, 63, 64, 127 }));
+
+	FUnHIDBitset Previous = Bitset;
+	Previous.Set(1, false);
+	Previous.Set(100, true);
+	const FUnHIDBitset ChangedBits = UUnHIDBlueprintFunctionLibrary::UnHIDBitsetXor(Bitset, Previous);
+	TestEqual("UnHIDBitsetGetSetBits(Xor) == { 1, 100 }", UUnHIDBlueprintFunctionLibrary::UnHIDBitsetGetSetBits(ChangedBits), TArray<int32>({ 1, 100 }));
+	TestTrue("Xor with itself IsZero()", UUnHIDBlueprintFunctionLibrary::UnHIDBitsetXor(Bitset, Bitset).IsZero());
+
+	// bits after the end of the report are 0
+	const FUnHIDBitset Truncated = UUnHIDBlueprintFunctionLibrary::UnHIDParseBitsetFromBytes(Report, 128, 70);
+	TestEqual("Truncated.NumBits == 70", Truncated.NumBits, 70);
+	TestEqual("UnHIDBitsetToBitmask(Truncated).Num() == 70", UUnHIDBlueprintFunctionLibrary::UnHIDBitsetToBitmask(Truncated).Num(), 70);
+	TestEqual("Truncated.CountSetBits() == 1", Truncated.CountSetBits(), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnHIDBenchmarks_ExtractBits, "UnHID.Benchmarks.ExtractBits", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FUnHIDBenchmarks_ExtractBits::RunTest(const FString& Parameters)
+{
+	// a 64 bytes report with 32 fields, decoded 100000 times
+	constexpr int32 NumIterations = 100000;
+
+	FRandomStream RandomStream(17);
+	TArray<uint8> Bytes;
+	TArray<int64> BitOffsets;
+	TArray<int32> BitSizes;
+	UnHIDUnitTests::FillRandomFields(RandomStream, Bytes, BitOffsets, BitSizes, 64, 32);
+
+	TArray<uint64> Values;
+	Values.SetNumZeroed(BitOffsets.Num());
+
+	// the checksums keep the compiler from removing the loops
+	uint64 ReferenceChecksum = 0;
+	const double ReferenceStart = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		for (int32 Index = 0; Index < BitOffsets.Num(); Index++)
+		{
+			ReferenceChecksum += UnHIDUnitTests::ExtractBitsReference(Bytes, BitOffsets[Index], BitSizes[Index]);
+		}
+	}
+	const double ReferenceSeconds = FPlatformTime::Seconds() - ReferenceStart;
+
+	uint64 WordChecksum = 0;
+	const double WordStart = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		for (int32 Index = 0; Index < BitOffsets.Num(); Index++)
+		{
+			WordChecksum += UnHID::ExtractBits(Bytes, BitOffsets[Index], BitSizes[Index]);
+		}
+	}
+	const double WordSeconds = FPlatformTime::Seconds() - WordStart;
+
+	uint64 BatchChecksum = 0;
+	const double BatchStart = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		UnHID::ExtractBitsBatch(Bytes, BitOffsets, BitSizes, Values);
+		for (const uint64 Value : Values)
+		{
+			BatchChecksum += Value;
+		}
+	}
+	const double BatchSeconds = FPlatformTime::Seconds() - BatchStart;
+
+	TestTrue("Word checksum == Reference checksum", WordChecksum == ReferenceChecksum);
+	TestTrue("Batch checksum == Reference checksum", BatchChecksum == ReferenceChecksum);
+
+	AddInfo(FString::Printf(TEXT("Bit by bit: %.3f ms"), ReferenceSeconds * 1000));
+	AddInfo(FString::Printf(TEXT("Word: %.3f ms (x%.2f)"), WordSeconds * 1000, ReferenceSeconds / FMath::Max(WordSeconds, 1e-9)));
+	AddInfo(FString::Printf(TEXT("Batch (%s): %.3f ms (x%.2f)"), UnHID::GetExtractBitsBatchKernelName(), BatchSeconds * 1000, ReferenceSeconds / FMath::Max(BatchSeconds, 1e-9)));
+
+	return true;
+}
+
 #endif
\ No newline at end of file
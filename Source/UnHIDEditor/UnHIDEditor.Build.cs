@@ -18,7 +18,8 @@ public class UnHIDEditor : ModuleRules
 
         PrivateIncludePaths.AddRange(
             new string[] {
-				// ... add other private include paths required here ...
+				// the unit tests access the reader of the UnHID module
+				Path.Combine(ModuleDirectory, "..", "UnHID", "Private")
 			}
             );
 